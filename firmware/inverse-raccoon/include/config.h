@@ -8,12 +8,48 @@
 
 
 // SYSTEM TIMING
-#define CONTROL_LOOP_PERIOD_MS    100
+#define CONTROL_LOOP_RATE_HZ      10    // Timer2-paced control rate (10-100 Hz)
+#define CONTROL_LOOP_PERIOD_MS    (1000 / CONTROL_LOOP_RATE_HZ)
+#define IDLE_SLEEP_ENABLED        1     // Sleep (IDLE mode) when no task is ready
+#ifndef PROFILING_ENABLED
+#define PROFILING_ENABLED         0     // Per-stage profiling (-DPROFILING_ENABLED=1)
+#endif
 #define WATCHDOG_TIMEOUT_MS       2000
-#define SENSOR_SAMPLE_COUNT       3
+#define SENSOR_SAMPLE_COUNT       3     // Samples per channel ring / filter block
 #define SCRUB_INTERVAL_MS         500
 #define SUN_LOSS_TIMEOUT_MS       5000
 
+// TELEMETRY
+#define TELEMETRY_DEFAULT_PERIOD_MS 1000
+#define TELEMETRY_MIN_PERIOD_MS   CONTROL_LOOP_PERIOD_MS   // One frame per control cycle
+#define TELEMETRY_MAX_PERIOD_MS   60000
+
+// FLIGHT RECORDER (one 14-byte packed record per control cycle, in SRAM;
+// the ring doubles as the calibration capture, so keep it >= 216 bytes)
+#define FLIGHT_RECORDER_RECORDS   16    // 1.6 s of history at 10 Hz
+#define FLIGHT_RECORDER_POST_RECORDS 4  // Cycles still logged after a trigger
+
+// TRAJECTORY (waypoint queue, 8 bytes per waypoint in SRAM)
+#define TRAJECTORY_QUEUE_DEPTH    8
+
+// SENSOR FILTERING (FILTER_MEDIAN, FILTER_TRIMMED_MEAN, FILTER_DECIMATE)
+#define SENSOR_FILTER_LDR         FILTER_MEDIAN
+#define SENSOR_FILTER_BATTERY     FILTER_DECIMATE
+#define SENSOR_FILTER_TRIM        1     // Samples dropped per end for trimmed mean
+
+// ADC OVERSAMPLING
+// 0 = off (LDRs come from the background sample rings). k = 1..3 takes 4^k
+// conversions per LDR each cycle and decimates to 10 + k bits; the burst
+// blocks the control task for (4^k + 1) * 4 * 104 us (~27 ms at k = 3).
+// The CPU sleeps in IDLE between conversions, not ADC Noise Reduction: NR
+// halts clkI/O, which stops Timer1 (servo pulses go flat or stretch) and
+// Timer2 (the control tick) as well as millis() and the UART for the whole
+// burst. Needs >= 1 LSB of noise on the inputs to gain resolution.
+#define SENSOR_OVERSAMPLE_BITS    0
+#define SENSOR_ADC_BITS           10
+#define SENSOR_RESOLUTION_BITS    (SENSOR_ADC_BITS + SENSOR_OVERSAMPLE_BITS)
+#define SENSOR_SNAPSHOT_MAX_AGE_MS  (2 * CONTROL_LOOP_PERIOD_MS)
+
 // HARDWARE PIN DEFINITIONS
 #define SENSOR_PIN_TOPLEFT        A0
 #define SENSOR_PIN_TOPRIGHT       A1
@@ -24,13 +60,51 @@
 #define SERVO_AZIMUTH_PIN         9
 #define SERVO_ELEVATION_PIN       10
 #define LED_HEARTBEAT_PIN         13
+// #define SERVO_POWER_PIN        8     // Optional servo supply switch (HIGH = on)
 
 // TRACKING PARAMETERS
 #define DEADBAND_DEGREES          2.0f
 #define PROPORTIONAL_GAIN         0.09f
+#define INTEGRAL_GAIN             0.01f
+#define DERIVATIVE_GAIN           0.0f
+#define FEEDFORWARD_GAIN          0.5f
+#define INTEGRAL_LIMIT_DEGREES    30.0f   // Anti-windup clamp on the error sum
+#define DERIVATIVE_FILTER_SHIFT   2       // IIR smoothing: 1/4 new sample per cycle
+#define SUN_RATE_HISTORY          8       // Cycles used to estimate sun rate
 // Servo physical limits (0-180 for standard servos)
 #define SERVO_MIN_DEG             0
 #define SERVO_MAX_DEG             180
+#define SERVO_CDEG_PER_DEG        100
+
+// Servo pulse endpoints (defaults match Servo::write() degree mapping)
+#define SERVO_DEFAULT_MIN_US      544
+#define SERVO_DEFAULT_MAX_US      2400
+#define SERVO_PULSE_LIMIT_MIN_US  400     // Accepted calibration range
+#define SERVO_PULSE_LIMIT_MAX_US  2600
+
+// SERVO BACKEND (override with -DSERVO_BACKEND=...)
+// LIBRARY: Arduino Servo, pulses timed by a Timer1 compare ISR (any pins).
+// TIMER1:  OC1A/OC1B hardware PWM, no ISR, 0.5 us steps (pins 9/10 only).
+#define SERVO_BACKEND_LIBRARY     0
+#define SERVO_BACKEND_TIMER1      1
+#ifndef SERVO_BACKEND
+#define SERVO_BACKEND             SERVO_BACKEND_LIBRARY
+#endif
+#define SERVO_FRAME_US            20000   // 50 Hz servo frame
+
+// Servo motion profile (trapezoidal, per axis, persisted in Config_t)
+#define SERVO_DEFAULT_SPEED_DPS   60      // Cruise speed, deg/s
+#define SERVO_DEFAULT_ACCEL_DPS2  120     // Acceleration/braking, deg/s^2
+#define SERVO_MAX_SPEED_DPS       600     // Accepted configuration range
+#define SERVO_MAX_ACCEL_DPS2      600
+#define SERVO_TICK_MAX_MS         250     // Cap on one planner step after a stall
+
+// Servo idle power management
+#define SERVO_IDLE_SETTLE_MS      3000    // Time at target before an axis detaches
+#define SERVO_REATTACH_CDEG       50      // Move needed to wake a detached axis
+#define SERVO_HOLD_CURRENT_MA     150     // Per-servo estimates for energy accounting
+#define SERVO_MOVE_CURRENT_MA     450
+#define SERVO_IDLE_CURRENT_MA     5       // Detached (or gated) draw
 
 // Azimuth operational limits (add safety margin from hard stops)
 #define MIN_AZIMUTH_DEG           0   // 10° margin from 0° hard stop
@@ -44,17 +118,54 @@
 #define DEFAULT_AZIMUTH_DEG       90
 #define DEFAULT_ELEVATION_DEG     90    
 
+// EPHEMERIS (open-loop tracking through occlusions)
+#define EPHEMERIS_UPDATE_MS       1000
+#define EPHEMERIS_REANCHOR_MS     3600000UL // Clock re-anchor period, far inside the millis() wrap
+#define EPHEMERIS_BIAS_SHIFT      4       // Mount-bias learning rate: 1/16 per cycle
+#define DEFAULT_MOUNT_AZIMUTH_DEG 180     // Compass bearing of servo azimuth 90
+
 // FAULT THRESHOLDS
 #define MAX_ERROR_COUNT           10
 #define SENSOR_MIN_VALUE          0
 #define SENSOR_MAX_VALUE          1023
 #define SUN_TRESHOLD              250
 
+// SENSOR HEALTH (10-bit counts, scaled up when oversampling)
+#define SENSOR_RAIL_LOW           4     // At/below = open or shorted divider
+#define SENSOR_RAIL_HIGH          1019
+#define SENSOR_MAX_STEP           300   // Max per-cycle jump the others don't share
+#define SENSOR_STUCK_NOISE        2     // Change that counts as "moving"
+#define SENSOR_STUCK_CYCLES       50    // Frozen cycles while others move
+#define SENSOR_CONSISTENCY_PCT    40    // Allowed TL*BR vs TR*BL mismatch
+#define SENSOR_POINTED_SPREAD_PCT 20    // Checked only while the 3 brightest agree this closely
+#define SENSOR_FAULT_PERSIST      5     // Failing cycles before a channel is dropped
+#define SENSOR_RECOVERY_CYCLES    20    // Clean cycles before it is trusted again
+
+// SENSOR CALIBRATION (piecewise-linear, 16-bit normalized domain)
+#define SENSOR_CAL_SEGMENT_BITS   3
+#define SENSOR_CAL_SEGMENTS       (1 << SENSOR_CAL_SEGMENT_BITS)
+#define SENSOR_CAL_KNOTS          (SENSOR_CAL_SEGMENTS + 1)
+#define SENSOR_CAL_MIN_SAMPLES    8     // Samples a knot needs during capture
+
 // EEPROM ADDRESSES
 #define CONFIG_PRIMARY_ADDR       0x0000
 #define CONFIG_BACKUP_ADDR        0x0100
+#define CONFIG_SAVE_SCAN_BYTES    32      // Unchanged bytes compared per background save step
 #define CONFIG_MAGIC              0xA55A
-#define CONFIG_VERSION            1
+#define CONFIG_VERSION            2     // 1 = baseline layout, migrated on boot
+
+// FAULT JOURNAL (EEPROM after both ECC config copies, to the end of EEPROM)
+#define JOURNAL_ADDR              0x0200
+#define JOURNAL_QUEUE_DEPTH       4       // Records waiting for EEPROM writes
+#define JOURNAL_REPEAT_MS         10000   // Same event again within this is only counted
+#define JOURNAL_SERVICE_PERIOD_MS 4       // One byte per call; a write takes 3.3 ms
+
+// CONSOLE (runtime status lines, printed between telemetry frames)
+#define CONSOLE_QUEUE_DEPTH       4
+// One staging buffer for telemetry frames and recorder/journal dumps, drained
+// as the 64-byte UART ring frees up. Must hold a COBS binary frame (99 bytes)
+// and the widest JSON section (~100 characters).
+#define SERIAL_STAGING_SIZE       112
 
 // CONTROL FLOW SIGNATURES
 #define SIG_INIT      0xA5A5
@@ -64,6 +175,8 @@
 #define SIG_EXPECTED  (SIG_INIT ^ SIG_SENSOR ^ SIG_TRACKING ^ SIG_SERVO)
 
 #define CMD_BUFFER_SIZE           64
-#define CMD_MAX_ARG_LENGTH        20
+#define CMD_MAX_ARGS              4     // Longest argument schema (PID)
+#define CMD_FRAME_TIMEOUT_MS      50    // Binary frame abandoned after this gap
+#define PID_GAIN_MAX_MILLI        1999  // Gain_t tops out just under 2.0
 
 #endif // CONFIG_H
\ No newline at end of file
@@ -27,9 +27,30 @@ Config_t* config_get_mutable();
 
 /**
  * @brief Persist configuration to both EEPROM locations
+ *
+ * Blocks for up to 512 EEPROM writes (3.3 ms each). For boot and
+ * shutdown paths only; tasks and commands use config_mark_dirty().
  */
 void config_persist();
 
+/**
+ * @brief Schedule a background save of the current configuration
+ *
+ * Call after changing the structure returned by config_get_mutable().
+ * A change while a save is running restarts it.
+ */
+void config_mark_dirty();
+
+/**
+ * @brief Advance a background save without blocking
+ *
+ * Checks up to CONFIG_SAVE_SCAN_BYTES encoded bytes and starts at most one
+ * EEPROM write, and only once the previous write has finished.
+ *
+ * @return true on the call that completes a save
+ */
+bool config_save_step();
+
 /**
  * @brief Validate configuration structure
  * @param cfg Configuration to validate
@@ -43,4 +64,10 @@ bool config_validate(const Config_t* cfg);
  */
 void config_load_defaults(Config_t* cfg);
 
+/**
+ * @brief Reset the sensor calibration to the identity curve
+ * @param cfg Configuration to update (CRC not refreshed)
+ */
+void config_default_sensor_cal(Config_t* cfg);
+
 #endif // CONFIG_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,61 @@
+/**
+ * @file console.h
+ * @brief Deferred status lines for the shared UART
+ *
+ * Telemetry frames and dumps are drained into the UART over several
+ * scheduler ticks, so a line printed straight to Serial from a task can
+ * land inside one. Runtime messages are queued here instead and printed
+ * by the drain task once nothing else owns the port.
+ */
+
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include "types.h"
+#include "utils/tx_buffer.h"
+
+typedef TxBuffer<SERIAL_STAGING_SIZE> SerialStage_t;
+
+/**
+ * @brief Queue a line
+ *
+ * Never blocks. Lines arriving with the queue full are counted and
+ * reported once it empties.
+ *
+ * @param text Message (F() string)
+ */
+void console_post(const __FlashStringHelper* text);
+
+/**
+ * @brief Queue a line ending in a number
+ * @param text Message (F() string)
+ * @param value Printed after text
+ */
+void console_post_value(const __FlashStringHelper* text, uint16_t value);
+
+/**
+ * @brief Queue a line ending in a name and a number
+ * @param text Message (F() string)
+ * @param name PROGMEM string printed after text
+ * @param value Printed after name
+ */
+void console_post_named(const __FlashStringHelper* text, PGM_P name, uint16_t value);
+
+/**
+ * @brief Staging buffer for whichever of telemetry, recorder dump or
+ *        journal dump currently owns the UART
+ *
+ * Only one of them runs at a time (see serial_tx_busy() in main.cpp), and
+ * each reports itself busy until its last byte has drained, so the next
+ * owner always finds the buffer free.
+ */
+SerialStage_t& console_stage();
+
+/**
+ * @brief Print the oldest queued line if the UART TX ring has room for it
+ *
+ * Call only while no telemetry frame or dump is draining.
+ */
+void console_flush_step();
+
+#endif // CONSOLE_H
\ No newline at end of file
@@ -0,0 +1,75 @@
+/**
+ * @file control_timer.h
+ * @brief Timer2 control-cycle tick with release jitter statistics
+ */
+
+#ifndef CONTROL_TIMER_H
+#define CONTROL_TIMER_H
+
+#include "types.h"
+
+#define CONTROL_JITTER_BUCKETS    8
+#define CONTROL_TIMESTAMP_US      4       // Microseconds per control_timer_timestamp() count
+
+/**
+ * @brief Control cycle timing statistics (microseconds)
+ */
+typedef struct {
+  uint16_t latency_min_us;   // Hardware release -> control task start
+  uint16_t latency_max_us;
+  uint32_t latency_sum_us;
+  uint16_t exec_min_us;      // Control task execution time
+  uint16_t exec_max_us;
+  uint32_t exec_sum_us;
+  uint32_t cycles;
+  uint16_t histogram[CONTROL_JITTER_BUCKETS];   // Latency, see control_timer_bucket_limit()
+  uint16_t last_latency_us;  // Most recent cycle
+  uint16_t last_exec_us;
+} ControlTiming_t;
+
+/**
+ * @brief Start the 1 kHz Timer2 tick
+ *
+ * Every CONTROL_LOOP_PERIOD_MS ticks the ISR releases the given scheduler
+ * task, so the cycle rate is set by hardware rather than by loop timing.
+ *
+ * @param task_index Scheduler index of the event-triggered control task
+ */
+void control_timer_init(uint8_t task_index);
+
+/**
+ * @brief Free-running Timer2 timestamp (tick count * 250 + TCNT2)
+ *
+ * 4 us (64 CPU cycles) per count, wraps after ~4.7 hours; use unsigned
+ * differences. Safe to call with interrupts enabled or disabled.
+ */
+uint32_t control_timer_timestamp();
+
+/**
+ * @brief Mark the start of a control cycle (records release latency)
+ */
+void control_timer_begin_cycle();
+
+/**
+ * @brief Mark the end of a control cycle (records execution time)
+ */
+void control_timer_end_cycle();
+
+/**
+ * @brief Current timing statistics
+ */
+const ControlTiming_t* control_timer_get_stats();
+
+/**
+ * @brief Upper latency bound of a histogram bucket (last bucket is open)
+ * @param bucket Bucket index
+ * @return Limit in microseconds, 0 for the open-ended last bucket
+ */
+uint16_t control_timer_bucket_limit(uint8_t bucket);
+
+/**
+ * @brief Clear the timing statistics
+ */
+void control_timer_reset_stats();
+
+#endif // CONTROL_TIMER_H
\ No newline at end of file
@@ -0,0 +1,68 @@
+/**
+ * @file ephemeris.h
+ * @brief Fixed-point solar ephemeris for open-loop tracking
+ */
+
+#ifndef EPHEMERIS_H
+#define EPHEMERIS_H
+
+#include "types.h"
+#include "utils/solar.h"
+
+/**
+ * @brief Initialize ephemeris engine (time unknown until set)
+ */
+void ephemeris_init();
+
+/**
+ * @brief Set wall-clock time
+ * @param unix_seconds UTC seconds since 1970-01-01
+ */
+void ephemeris_set_time(uint32_t unix_seconds);
+
+/**
+ * @brief Get current UTC time estimate
+ *
+ * Re-anchors the clock every EPHEMERIS_REANCHOR_MS so it survives the
+ * millis() wrap; ephemeris_get_position() calls it every control cycle.
+ *
+ * @return Unix seconds, 0 if never set
+ */
+uint32_t ephemeris_get_time();
+
+/**
+ * @brief Check that both time and site are known
+ */
+bool ephemeris_is_valid();
+
+/**
+ * @brief Compute sun position for a given time at the configured site
+ *
+ * See solar_position() for the method.
+ *
+ * @param unix_seconds UTC time
+ * @param position Output sun direction
+ */
+void ephemeris_compute(uint32_t unix_seconds, SolarPosition_t* position);
+
+/**
+ * @brief Get sun position now (recomputed at most every EPHEMERIS_UPDATE_MS)
+ * @param position Output sun direction
+ * @return false if time or site are not set
+ */
+bool ephemeris_get_position(SolarPosition_t* position);
+
+/**
+ * @brief Map a sun direction onto servo axes for the configured mount
+ *
+ * Directions behind the azimuth servo's 180 degree span are reached by
+ * flipping elevation past zenith, matching the tracker's inverted mode.
+ *
+ * @param position Sun direction
+ * @param azimuth Output servo azimuth
+ * @param elevation Output servo elevation
+ * @return false if the sun is below the horizon
+ */
+bool ephemeris_to_servo(const SolarPosition_t* position, Angle_t* azimuth, Angle_t* elevation);
+
+#endif // EPHEMERIS_H
@@ -0,0 +1,114 @@
+/**
+ * @file flight_recorder.h
+ * @brief Per-cycle flight recorder: bit-packed SRAM ring, frozen on faults
+ */
+
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include "types.h"
+
+// FlightSample_t.flags
+#define FR_FLAG_VALID             0x01    // Sensor reading valid
+#define FR_FLAG_SUN               0x02    // Sun detected
+#define FR_FLAG_MOVING            0x04    // A servo is still profiling a move
+
+#define FR_RECORD_BYTES           14      // One packed FlightSample_t
+#define FLIGHT_RECORDER_RING_BYTES  (FLIGHT_RECORDER_RECORDS * FR_RECORD_BYTES)
+
+/**
+ * @brief What froze the recorder
+ */
+typedef enum {
+  FR_TRIGGER_NONE = 0,     // Still recording
+  FR_TRIGGER_ERROR,        // safety_log_error(), detail = ErrorCode_t
+  FR_TRIGGER_MODE,         // Entered SAFE/EMERGENCY, detail = SystemMode_t
+  FR_TRIGGER_MANUAL        // REC FREEZE / REC DUMP
+} FlightTrigger_t;
+
+/**
+ * @brief One control cycle, unpacked
+ *
+ * Packed to 14 bytes; fields saturate at their stored width.
+ */
+typedef struct {
+  uint16_t ldr[SENSOR_CH_COUNT];   // 10-bit scale
+  uint16_t azimuth_cdeg;           // Commanded, 15 bits
+  uint16_t elevation_cdeg;
+  uint8_t mode;                    // SystemMode_t
+  uint8_t control_mode;            // ControlMode_t
+  uint8_t healthy_mask;
+  uint8_t flags;                   // FR_FLAG_*
+  uint8_t sensor_errors;           // Saturate at 7
+  uint8_t servo_errors;
+  uint16_t exec_us;                // 64 us resolution, up to 32 ms
+  uint16_t latency_us;             // 16 us resolution, up to 2 ms
+} FlightSample_t;
+
+/**
+ * @brief Clear the ring and start recording
+ */
+void flight_recorder_init();
+
+/**
+ * @brief Append one control cycle (no-op once frozen)
+ */
+void flight_recorder_log(const FlightSample_t* sample);
+
+/**
+ * @brief Freeze after FLIGHT_RECORDER_POST_RECORDS more cycles
+ *
+ * Only the first trigger is kept until flight_recorder_rearm().
+ * @param reason Trigger type
+ * @param detail Error code or mode, per FlightTrigger_t
+ */
+void flight_recorder_trigger(FlightTrigger_t reason, uint8_t detail);
+
+/**
+ * @brief Discard the frozen history and record again
+ * @return false while the ring is lent out
+ */
+bool flight_recorder_rearm();
+
+/**
+ * @brief Lend the ring to a calibration capture as scratch memory
+ *
+ * Discards the history and stops recording until flight_recorder_reclaim().
+ * @return FLIGHT_RECORDER_RING_BYTES of zeroed memory
+ */
+void* flight_recorder_lend();
+
+/**
+ * @brief Take the ring back from the capture and start recording again
+ */
+void flight_recorder_reclaim();
+
+/**
+ * @brief true once the post-trigger records are in
+ */
+bool flight_recorder_is_frozen();
+
+/**
+ * @brief Print state, trigger and record count
+ */
+void flight_recorder_print_status();
+
+/**
+ * @brief Freeze (if still recording) and queue a dump of every record
+ */
+void flight_recorder_start_dump();
+
+/**
+ * @brief Print the next queued record line if the UART ring has room
+ *
+ * Never blocks; call until it returns false.
+ * @return true while lines remain
+ */
+bool flight_recorder_dump_step();
+
+/**
+ * @brief true until the last dump line has left the staging buffer
+ */
+bool flight_recorder_is_dumping();
+
+#endif // FLIGHT_RECORDER_H
\ No newline at end of file
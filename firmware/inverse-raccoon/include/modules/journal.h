@@ -0,0 +1,75 @@
+/**
+ * @file journal.h
+ * @brief Append-only fault journal in EEPROM
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "types.h"
+
+// Journal codes beyond ErrorCode_t
+#define JOURNAL_EVENT_BOOT        0x40    // context = MCUSR reset flags
+#define JOURNAL_EVENT_MODE        0x41    // context = SystemMode_t entered
+
+/**
+ * @brief One journal entry as stored in EEPROM
+ */
+typedef struct __attribute__((packed)) {
+  uint16_t seq;              // Increments per record, locates the head
+  uint16_t boot;             // Config boot_count, low 16 bits
+  uint32_t uptime_ms;
+  uint8_t code;              // ErrorCode_t or JOURNAL_EVENT_*
+  uint8_t mode;              // SystemMode_t when logged
+  uint16_t context;          // Code-specific detail
+  uint16_t crc16;            // Over the fields above
+} JournalRecord_t;
+
+/**
+ * @brief Find the head of the ring and journal this boot
+ *
+ * Call after config_manager_init() (for the boot count).
+ * @param reset_flags MCUSR as read at startup
+ */
+void journal_init(uint8_t reset_flags);
+
+/**
+ * @brief Queue an event for the journal
+ *
+ * Never blocks. Repeats of the last code within JOURNAL_REPEAT_MS and
+ * events arriving with the queue full are counted instead of written.
+ *
+ * @param code ErrorCode_t or JOURNAL_EVENT_*
+ * @param context Code-specific detail
+ */
+void journal_log(uint8_t code, uint16_t context);
+
+/**
+ * @brief Write at most one queued byte if the EEPROM is idle
+ */
+void journal_service();
+
+/**
+ * @brief Print record count, next sequence number and loss counters
+ */
+void journal_print_status();
+
+/**
+ * @brief Queue an export of every valid record, oldest first
+ */
+void journal_start_dump();
+
+/**
+ * @brief Print the next export line if the UART ring has room
+ *
+ * Never blocks; call until it returns false.
+ * @return true while lines remain
+ */
+bool journal_dump_step();
+
+/**
+ * @brief true until the last export line has left the buffer
+ */
+bool journal_is_dumping();
+
+#endif // JOURNAL_H
\ No newline at end of file
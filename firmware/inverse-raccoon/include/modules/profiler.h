@@ -0,0 +1,76 @@
+/**
+ * @file profiler.h
+ * @brief Per-stage execution profiling (compiled out unless PROFILING_ENABLED)
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "types.h"
+
+/**
+ * @brief Profiled stages
+ */
+typedef enum {
+  PROF_CONTROL = 0,    // Whole control task
+  PROF_COMMAND,
+  PROF_SENSOR,
+  PROF_POSITION,
+  PROF_TRACKING,
+  PROF_SERVO,
+  PROF_SAFETY,
+  PROF_SCRUB,
+  PROF_TELEMETRY,
+  PROF_CONFIG_SAVE,
+  PROF_STAGE_COUNT     // Must be last
+} ProfileStage_t;
+
+#if PROFILING_ENABLED
+
+#include "modules/control_timer.h"
+
+/**
+ * @brief Open a profiled region; pair with PROF_END in the same scope
+ */
+#define PROF_BEGIN(stage) uint32_t prof_start_##stage = control_timer_timestamp()
+
+/**
+ * @brief Close a profiled region and record its duration
+ */
+#define PROF_END(stage) profiler_record(stage, control_timer_timestamp() - prof_start_##stage)
+
+/**
+ * @brief Add one sample to a stage
+ * @param stage ProfileStage_t
+ * @param counts Duration in control_timer_timestamp() counts
+ */
+void profiler_record(uint8_t stage, uint32_t counts);
+
+#else
+
+#define PROF_BEGIN(stage) do {} while (0)
+#define PROF_END(stage) do {} while (0)
+
+#endif
+
+/**
+ * @brief Print the stage table (count, min/max/mean in us)
+ */
+void profiler_print();
+
+/**
+ * @brief Clear all stage statistics
+ */
+void profiler_reset();
+
+/**
+ * @brief Enable or disable printing the table with every telemetry frame
+ */
+void profiler_set_streaming(bool enabled);
+
+/**
+ * @brief Whether the table is streamed with telemetry
+ */
+bool profiler_is_streaming();
+
+#endif // PROFILER_H
\ No newline at end of file
@@ -0,0 +1,132 @@
+/**
+ * @file scheduler.h
+ * @brief Static-table cooperative scheduler with budget and overrun accounting
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "types.h"
+
+typedef void (*TaskFunction_t)(uint32_t now);
+
+#define SCHEDULER_MAX_TASKS       8
+
+/**
+ * @brief What releases a task
+ */
+typedef enum {
+  TASK_PERIODIC = 0,   // Released every period_ms from millis()
+  TASK_EVENT           // Released by scheduler_release(); period_ms is the expected rate
+} TaskTrigger_t;
+
+/**
+ * @brief Per-task runtime bookkeeping
+ */
+typedef struct {
+  uint32_t next_release;     // millis() deadline of the next release
+  uint32_t run_count;
+  uint16_t max_exec_us;
+  uint16_t overruns;         // Executions longer than budget_us
+  uint16_t skipped;          // Releases dropped because the task ran late
+} TaskStats_t;
+
+/**
+ * @brief Scheduler task entry (PROGMEM)
+ *
+ * The period and statistics live in SRAM inside the scheduler.
+ */
+typedef struct {
+  const char* name;          // PROGMEM string
+  TaskFunction_t run;
+  uint8_t trigger;           // TaskTrigger_t
+  uint16_t period_ms;        // Initial period, see scheduler_set_period()
+  uint8_t priority;          // 0 = highest (control path)
+  uint16_t budget_us;        // Worst-case execution time allowance
+} Task_t;
+
+/**
+ * @brief Attach the task table and schedule every task's first release
+ * @param tasks Static task table in PROGMEM
+ * @param count Number of entries (at most SCHEDULER_MAX_TASKS)
+ * @param now Current millis()
+ */
+void scheduler_init(const Task_t* tasks, uint8_t count, uint32_t now);
+
+/**
+ * @brief Run at most one ready task
+ *
+ * Picks the highest-priority released task (earliest deadline on ties).
+ * Background tasks only start if their budget fits before the next release
+ * of a higher-priority task, unless they have waited a full period.
+ *
+ * @return true if a task ran, false if the scheduler is idle
+ */
+bool scheduler_run();
+
+/**
+ * @brief Sleep until the next interrupt if no event task is pending
+ *
+ * Uses SLEEP_MODE_IDLE: the CPU clock stops but Timer0 (millis), Timer2
+ * (control tick) and the UART keep running, so any of them wakes the loop
+ * and serial RX is not lost. Call when scheduler_run() returns false.
+ */
+void scheduler_idle();
+
+/**
+ * @brief Time spent asleep versus elapsed since the last stats reset
+ * @param sleep_ms Output, milliseconds asleep
+ * @param elapsed_ms Output, milliseconds since reset
+ */
+void scheduler_get_sleep_stats(uint32_t* sleep_ms, uint32_t* elapsed_ms);
+
+/**
+ * @brief Release an event-triggered task (safe to call from an ISR)
+ *
+ * A release that arrives while the previous one is still pending is
+ * counted as skipped.
+ *
+ * @param index Task table index
+ */
+void scheduler_release(uint8_t index);
+
+/**
+ * @brief Change a periodic task's period at runtime
+ *
+ * Takes effect from the next release; a shorter period also pulls a
+ * distant next release in so the new rate starts promptly.
+ *
+ * @param index Task table index
+ * @param period_ms New period (non-zero)
+ */
+void scheduler_set_period(uint8_t index, uint16_t period_ms);
+
+/**
+ * @brief Number of tasks in the table
+ */
+uint8_t scheduler_get_task_count();
+
+/**
+ * @brief Task table entry by index
+ * @return PROGMEM entry (read with memcpy_P), or nullptr if out of range
+ */
+const Task_t* scheduler_get_task(uint8_t index);
+
+/**
+ * @brief Current period of a task
+ * @return Period in ms, or 0 if out of range
+ */
+uint16_t scheduler_get_period(uint8_t index);
+
+/**
+ * @brief Task statistics by index
+ * @return Statistics, or nullptr if out of range
+ */
+const TaskStats_t* scheduler_get_stats(uint8_t index);
+
+/**
+ * @brief Clear execution statistics for all tasks
+ */
+void scheduler_reset_stats();
+
+#endif // SCHEDULER_H
\ No newline at end of file
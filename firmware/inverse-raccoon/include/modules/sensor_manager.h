@@ -9,19 +9,45 @@
 #include "types.h"
 
 /**
- * @brief Initialize sensor manager
+ * @brief Initialize sensor manager and start interrupt-driven ADC acquisition
+ *
+ * The ADC ISR continuously round-robins the four photoresistors and the
+ * battery divider into per-channel sample rings. analogRead() must not be
+ * used on those pins afterwards.
  */
 void sensor_manager_init();
 
 /**
- * @brief Read all sensors with median filtering and fault detection
- * @param reading Output structure for sensor readings
- * @return true if readings are valid, false otherwise
+ * @brief Acquire this cycle's sensor snapshot
+ *
+ * Filters the samples already collected by the ADC ISR (median filtering
+ * and fault detection) into the cached snapshot and bumps its generation.
+ * Call exactly once per control cycle; everything else should use
+ * sensor_get_snapshot().
+ *
+ * @return Pointer to the refreshed snapshot
  */
-bool sensor_read_all(SensorReading_t* reading);
+const SensorSnapshot_t* sensor_acquire();
+
+/**
+ * @brief Get the snapshot from the most recent acquisition
+ * @return Pointer to cached snapshot (generation 0 before first acquire)
+ */
+const SensorSnapshot_t* sensor_get_snapshot();
+
+/**
+ * @brief Check whether the cached snapshot is recent enough to act on
+ * @param max_age_ms Maximum acceptable age in milliseconds
+ * @return true if a snapshot exists and is no older than max_age_ms
+ */
+bool sensor_snapshot_is_fresh(uint32_t max_age_ms);
 
 /**
  * @brief Calculate sun position from sensor readings
+ *
+ * Uses all four quadrants when healthy; with one channel flagged it
+ * estimates both axes from the three remaining quadrants.
+ *
  * @param reading Input sensor readings
  * @param position Output sun position structure
  */
@@ -33,6 +59,61 @@ void sensor_calculate_position(const SensorReading_t* reading, SunPosition_t* po
  */
 const SunPosition_t* sensor_get_position();
 
+/**
+ * @brief Get health verdict for one photoresistor
+ * @param channel SensorChannel_t index
+ * @return Current health (SENSOR_HEALTH_OK for out-of-range channels)
+ */
+SensorHealth_t sensor_get_channel_health(uint8_t channel);
+
+/**
+ * @brief Rebuild the calibration LUT from the stored configuration
+ */
+void sensor_reload_calibration();
+
+/**
+ * @brief Start recording channel responses for calibration
+ *
+ * Cover the sensor head with a diffuser and sweep the light level from
+ * dark to full sun while capturing. The capture borrows the flight
+ * recorder's ring, so its history is discarded and recording pauses until
+ * the capture ends.
+ */
+void sensor_cal_start();
+
+/**
+ * @brief Discard the capture in progress
+ */
+void sensor_cal_abort();
+
+/**
+ * @brief Check if a calibration capture is running
+ */
+bool sensor_cal_is_capturing();
+
+/**
+ * @brief Fit per-channel curves from the capture and schedule a config save
+ *
+ * Ends the capture only on success; a rejected fit keeps it running so
+ * the sweep can be extended before trying again.
+ *
+ * @return false if no capture is running or the sweep did not cover
+ *         enough of the range
+ */
+bool sensor_cal_finish();
+
+/**
+ * @brief End any capture, restore identity calibration and schedule a
+ *        config save
+ */
+void sensor_cal_reset();
+
+/**
+ * @brief Get filtered battery divider reading
+ * @return Raw ADC counts (0 until the sample rings are primed)
+ */
+uint16_t sensor_read_battery();
+
 /**
  * @brief Get error count for sensor faults
  * @return Number of sensor faults detected
@@ -14,12 +14,66 @@
 void servo_driver_init();
 
 /**
- * @brief Execute servo command with verification
+ * @brief Validate a servo command and latch it as the motion target
+ *
+ * The move itself is carried out by servo_driver_tick(). Positions are
+ * converted to pulse widths through the per-axis endpoint calibration,
+ * giving ~0.1 degree actuation steps.
+ *
  * @param cmd Servo command structure with CRC
  * @return true if successful, false otherwise
  */
 bool servo_execute_command(const ServoCommand_t* cmd);
 
+/**
+ * @brief Advance the motion profiles, update the pulses and apply the
+ * idle detach policy
+ * @param now Current time in milliseconds (call every control cycle)
+ */
+void servo_driver_tick(uint32_t now);
+
+/**
+ * @brief Check whether an axis is still travelling to its target
+ * @param axis ServoAxis_t index
+ */
+bool servo_is_in_motion(uint8_t axis);
+
+/**
+ * @brief Check whether both axes have reached their targets
+ */
+bool servo_at_target();
+
+/**
+ * @brief Current profiled (not target) position of both axes
+ * @param position Output, centidegrees, CRC filled in
+ */
+void servo_get_position(ServoCommand_t* position);
+
+/**
+ * @brief Duty-cycle and estimated energy since boot
+ * @param stats Output
+ */
+void servo_get_power_stats(ServoPowerStats_t* stats);
+
+/**
+ * @brief Set the motion limits for one axis and schedule a config save
+ * @param axis ServoAxis_t index
+ * @param max_speed Cruise speed in 0.01 deg/s (0 = no profiling)
+ * @param max_accel Acceleration in 0.01 deg/s^2 (0 = no profiling)
+ * @return false if out of range
+ */
+bool servo_set_motion_limits(uint8_t axis, uint16_t max_speed, uint16_t max_accel);
+
+/**
+ * @brief Set pulse-width endpoints for one axis and schedule a config save
+ * @param axis ServoAxis_t index
+ * @param min_us Pulse width at 0 degrees (may exceed max_us for reversed servos)
+ * @param max_us Pulse width at 180 degrees
+ * @return false if either end is outside the SERVO_PULSE_LIMIT range, or
+ *         both are equal
+ */
+bool servo_set_endpoints(uint8_t axis, uint16_t min_us, uint16_t max_us);
+
 /**
  * @brief Get error count for servo faults
  * @return Number of servo write failures
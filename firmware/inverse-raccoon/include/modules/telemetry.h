@@ -8,12 +8,85 @@
 
 #include "types.h"
 
+/**
+ * @brief Telemetry frame encoding
+ */
+typedef enum {
+  TELEMETRY_FORMAT_JSON = 0,   // Human-readable JSON line
+  TELEMETRY_FORMAT_BINARY      // COBS-framed binary, see protocol.h
+} TelemetryFormat_t;
+
 void telemetry_init();
 void telemetry_print_status();
 void telemetry_print_sensors(const SensorReading_t* reading);
 void telemetry_print_servos(const ServoCommand_t* cmd);
 void telemetry_update_heartbeat();
-void telemetry_print_json(const SensorReading_t* sensor_data, 
-                          const ServoCommand_t* servo_cmd);
+
+/**
+ * @brief Stage one telemetry frame in the selected format and start sending it
+ *
+ * Never blocks on the UART; telemetry_drain() sends the rest.
+ * @return false (frame skipped and counted) if the previous frame is still
+ *         draining
+ */
+bool telemetry_send(const SensorSnapshot_t* snapshot,
+                    const ServoCommand_t* servo_cmd);
+
+/**
+ * @brief Move staged frame bytes into the UART ring, as many as fit
+ */
+void telemetry_drain();
+
+/**
+ * @brief true while a frame is partly sent; other serial output would split it
+ */
+bool telemetry_is_busy();
+
+/**
+ * @brief Frames skipped because the previous one was still draining
+ */
+uint16_t telemetry_get_skipped();
+
+/**
+ * @brief Bind the telemetry task and apply the persisted rate and fields
+ *
+ * Call after config_manager_init() and scheduler_init().
+ * @param task_index Scheduler index of the telemetry task
+ */
+void telemetry_start(uint8_t task_index);
+
+/**
+ * @brief Set the telemetry period and schedule a background config save
+ * @param period_ms TELEMETRY_MIN_PERIOD_MS (every control cycle) to
+ *        TELEMETRY_MAX_PERIOD_MS
+ * @return false if out of range
+ */
+bool telemetry_set_period(uint16_t period_ms);
+
+/**
+ * @brief Current telemetry period (ms)
+ */
+uint16_t telemetry_get_period();
+
+/**
+ * @brief Set the field subscription and schedule a background config save
+ * @param groups TELEM_GROUP_* mask (protocol.h); metadata is always sent
+ */
+void telemetry_set_groups(uint8_t groups);
+
+/**
+ * @brief Current field subscription, TELEM_GROUP_* mask
+ */
+uint8_t telemetry_get_groups();
+
+/**
+ * @brief Select the telemetry frame format
+ */
+void telemetry_set_format(TelemetryFormat_t format);
+
+/**
+ * @brief Current telemetry frame format
+ */
+TelemetryFormat_t telemetry_get_format();
 
 #endif // TELEMETRY_H
\ No newline at end of file
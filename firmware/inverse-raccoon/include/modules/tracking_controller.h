@@ -1,6 +1,6 @@
 /**
  * @file tracking_controller.h
- * @brief Proportional tracking controller with dead-band
+ * @brief PID tracking controller with sun-rate feedforward and dead-band
  */
 
 #ifndef TRACKING_CONTROLLER_H
@@ -20,6 +20,18 @@ void tracking_controller_init();
  */
 void tracking_calculate_command(const SunPosition_t* position, ServoCommand_t* cmd);
 
+/**
+ * @brief Replace controller gains (takes effect next cycle)
+ * @param gains New gain set
+ */
+void tracking_set_gains(const TrackingGains_t* gains);
+
+/**
+ * @brief Get active controller gains
+ * @return Pointer to current gain set
+ */
+const TrackingGains_t* tracking_get_gains();
+
 /**
  * @brief Update last sun detection time
  * @param timestamp Time in milliseconds
@@ -0,0 +1,91 @@
+/**
+ * @file trajectory.h
+ * @brief Timed waypoint queue and trajectory executor
+ *
+ * The host queues (time, azimuth, elevation) points, times in ms from the
+ * start of the trajectory. Each control cycle the executor interpolates
+ * between the two waypoints around the current time. Points may be added
+ * while it runs, so long paths stream through the bounded queue.
+ */
+
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include "types.h"
+
+/**
+ * @brief One queued point
+ */
+typedef struct {
+  uint32_t time_ms;          // From trajectory start
+  uint16_t azimuth_cdeg;     // 0.01 degree
+  uint16_t elevation_cdeg;
+} Waypoint_t;
+
+/**
+ * @brief Executor state
+ */
+typedef enum {
+  TRAJ_IDLE = 0,     // Not started (points may be queued)
+  TRAJ_RUNNING,      // Interpolating
+  TRAJ_STARVED,      // Underrun: queue ran dry before trajectory_end()
+  TRAJ_FINISHED      // Reached the last point after trajectory_end()
+} TrajectoryState_t;
+
+/**
+ * @brief trajectory_add() outcome
+ */
+typedef enum {
+  TRAJ_ADD_OK = 0,
+  TRAJ_ADD_FULL,     // Overrun: queue full, point dropped
+  TRAJ_ADD_RANGE,    // Outside the azimuth/elevation limits
+  TRAJ_ADD_ORDER,    // Not later than the previous point
+  TRAJ_ADD_CLOSED    // After trajectory_end()
+} TrajectoryAdd_t;
+
+/**
+ * @brief Empty the queue and return to TRAJ_IDLE
+ */
+void trajectory_clear();
+
+/**
+ * @brief Queue a waypoint
+ * @param point Times must strictly increase
+ * @return TRAJ_ADD_OK, or why the point was dropped
+ */
+TrajectoryAdd_t trajectory_add(const Waypoint_t* point);
+
+/**
+ * @brief Start the clock on the next control cycle
+ *
+ * The servo position at that moment is the origin, interpolated towards
+ * the first waypoint.
+ * @return false unless TRAJ_IDLE
+ */
+bool trajectory_start();
+
+/**
+ * @brief Mark the last point queued; the executor finishes there
+ */
+void trajectory_end();
+
+/**
+ * @brief Advance one control cycle
+ * @param now millis()
+ * @param azimuth_cdeg In: current command (origin on the first cycle).
+ *                     Out: target for this cycle
+ * @param elevation_cdeg As azimuth_cdeg
+ */
+void trajectory_tick(uint32_t now, uint16_t* azimuth_cdeg, uint16_t* elevation_cdeg);
+
+/**
+ * @brief Current executor state
+ */
+TrajectoryState_t trajectory_get_state();
+
+/**
+ * @brief Print state, queue fill and underrun/overrun counts
+ */
+void trajectory_print_status();
+
+#endif // TRAJECTORY_H
\ No newline at end of file
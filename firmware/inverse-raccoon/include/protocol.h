@@ -0,0 +1,189 @@
+/**
+ * @file protocol.h
+ * @brief Binary telemetry and command wire formats, shared by firmware and
+ *        host tools
+ *
+ * Frame on the wire:  0x00 | COBS(header, sections..., crc16) | 0x00
+ *
+ * The leading delimiter resynchronises a receiver after any text log line.
+ * All multi-byte fields are little-endian. A section follows the header for
+ * every bit set in header.groups, in ascending bit order. crc16 is the
+ * firmware's CRC-16-CCITT (poly 0x1021, init 0xFFFF) over header and
+ * sections. Only <stdint.h> is used so host tools can include this file.
+ */
+
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <stdint.h>
+
+#define TELEM_FRAME_TYPE          0x54    // 'T'
+#define TELEM_PROTOCOL_VERSION    2
+#define TELEM_FRAME_DELIMITER     0x00
+
+#define TELEM_ANGLE_FRAC          6       // Sun errors are Q6 degrees
+#define TELEM_CHANNELS            4       // LDR quadrants: TL, TR, BL, BR
+#define TELEM_AXES                2       // Azimuth, elevation
+#define TELEM_JITTER_BUCKETS      8
+
+// Field groups (header.groups bits), emitted in this order
+#define TELEM_GROUP_SENSORS       0x01
+#define TELEM_GROUP_SUN           0x02
+#define TELEM_GROUP_SERVOS        0x04
+#define TELEM_GROUP_POWER         0x08
+#define TELEM_GROUP_TIMING        0x10
+#define TELEM_GROUP_ERRORS        0x20
+#define TELEM_GROUP_HEALTH        0x40
+#define TELEM_GROUP_ALL           0x7F
+
+typedef struct __attribute__((packed)) {
+  uint8_t type;                   // TELEM_FRAME_TYPE
+  uint8_t version;                // TELEM_PROTOCOL_VERSION
+  uint16_t seq;                   // Increments per frame (any format)
+  uint32_t uptime_ms;
+  uint8_t mode;                   // SystemMode_t
+  uint8_t groups;                 // TELEM_GROUP_* present
+} TelemHeader_t;
+
+typedef struct __attribute__((packed)) {
+  uint16_t ldr[TELEM_CHANNELS];   // Calibrated, resolution_bits wide
+  uint8_t resolution_bits;
+  uint8_t valid;
+  uint32_t generation;            // Sensor snapshot generation
+} TelemSensors_t;
+
+typedef struct __attribute__((packed)) {
+  int16_t azimuth_error;          // Q6 degrees
+  int16_t elevation_error;        // Q6 degrees
+  uint8_t detected;
+} TelemSun_t;
+
+typedef struct __attribute__((packed)) {
+  uint16_t azimuth_cdeg;          // Commanded, 0.01 degree
+  uint16_t elevation_cdeg;
+  uint8_t moving;
+} TelemServos_t;
+
+typedef struct __attribute__((packed)) {
+  uint8_t attached_mask;          // Bit per axis
+  uint16_t duty_hundredths[TELEM_AXES];   // Attached time, 0.01 %
+  uint32_t charge_mas;            // Estimated servo charge, mA*s
+} TelemPower_t;
+
+typedef struct __attribute__((packed)) {
+  uint16_t rate_hz;
+  uint32_t cycles;
+  uint16_t latency_us[3];         // Min, max, mean
+  uint16_t exec_us[3];            // Min, max, mean
+  uint16_t histogram[TELEM_JITTER_BUCKETS];
+  uint16_t sleep_hundredths;      // Idle sleep share, 0.01 %
+} TelemTiming_t;
+
+typedef struct __attribute__((packed)) {
+  uint32_t total;
+  uint16_t sensor;
+  uint16_t servo;
+  uint16_t telemetry_skipped;     // Frames dropped while one was draining (v2)
+} TelemErrors_t;
+
+typedef struct __attribute__((packed)) {
+  uint8_t channel_health[TELEM_CHANNELS];  // SensorHealth_t per channel
+  uint8_t healthy_mask;
+} TelemHealth_t;
+
+#define TELEM_MAX_PAYLOAD  (sizeof(TelemHeader_t) + sizeof(TelemSensors_t) + \
+                            sizeof(TelemSun_t) + sizeof(TelemServos_t) +     \
+                            sizeof(TelemPower_t) + sizeof(TelemTiming_t) +   \
+                            sizeof(TelemErrors_t) + sizeof(TelemHealth_t) +  \
+                            sizeof(uint16_t))
+
+// COBS adds one byte per 254 plus one; two delimiters frame it
+#define TELEM_MAX_FRAME    (TELEM_MAX_PAYLOAD + TELEM_MAX_PAYLOAD / 254 + 1 + 2)
+
+// ============================================================================
+// COMMAND FRAMES (host to tracker)
+// ============================================================================
+//
+// Request:  0x00 | COBS(CmdHeader_t, count x (opcode, length, payload), crc16) | 0x00
+// Reply:    0x00 | COBS(CmdAckHeader_t, count x status, crc16) | 0x00
+//
+// Text command lines never contain 0x00, so both kinds share the port. The
+// commands of one request run in order; after the first failure the rest
+// are not run and report CMD_STATUS_SKIPPED. A request that cannot be
+// trusted as a whole (bad COBS, CRC, version or layout) runs nothing and is
+// answered with that status in the header and count 0.
+
+#define CMD_FRAME_TYPE            0x43    // 'C'
+#define CMD_ACK_TYPE              0x41    // 'A'
+#define CMD_PROTOCOL_VERSION      1
+#define CMD_FRAME_DELIMITER       0x00
+#define CMD_MAX_ENCODED           60      // COBS bytes between the delimiters;
+                                          // a whole frame fits the UART RX ring
+#define CMD_MAX_BATCH             8       // Commands per request
+
+// Opcodes and their payloads
+#define CMD_OP_PING               0x01    // None
+#define CMD_OP_AUTO               0x02    // None
+#define CMD_OP_HOME               0x03    // None
+#define CMD_OP_DEMO               0x04    // None
+#define CMD_OP_MANUAL             0x05    // CmdManual_t
+#define CMD_OP_PID                0x06    // CmdPid_t
+#define CMD_OP_TIME               0x07    // uint32_t unix seconds (UTC)
+#define CMD_OP_TELEM_RATE         0x08    // uint16_t period ms
+#define CMD_OP_TELEM_FIELDS       0x09    // uint8_t TELEM_GROUP_* mask
+#define CMD_OP_TELEM_FORMAT       0x0A    // uint8_t 0 = JSON, 1 = binary
+#define CMD_OP_WP_ADD             0x0B    // CmdWaypoint_t
+#define CMD_OP_WP_START           0x0C    // None
+#define CMD_OP_WP_END             0x0D    // None (no more waypoints)
+#define CMD_OP_WP_CLEAR           0x0E    // None
+
+// Reply status codes
+#define CMD_STATUS_OK             0
+#define CMD_STATUS_BAD_FRAME      1       // COBS error, truncated or too long
+#define CMD_STATUS_BAD_CRC        2
+#define CMD_STATUS_BAD_VERSION    3       // Wrong type or CMD_PROTOCOL_VERSION
+#define CMD_STATUS_UNKNOWN_OP     4
+#define CMD_STATUS_BAD_LENGTH     5       // Payload length wrong for the opcode
+#define CMD_STATUS_OUT_OF_RANGE   6
+#define CMD_STATUS_REJECTED       7       // Valid, but not in the current state
+#define CMD_STATUS_SKIPPED        8       // An earlier command in the batch failed
+#define CMD_STATUS_QUEUE_FULL     9       // Waypoint queue full; retry after it drains
+
+typedef struct __attribute__((packed)) {
+  uint8_t type;                   // CMD_FRAME_TYPE
+  uint8_t version;                // CMD_PROTOCOL_VERSION
+  uint16_t request_id;            // Echoed in the reply
+  uint8_t count;                  // Commands that follow, 1..CMD_MAX_BATCH
+} CmdHeader_t;
+
+typedef struct __attribute__((packed)) {
+  uint8_t opcode;
+  uint8_t length;                 // Payload bytes that follow
+} CmdRecord_t;
+
+typedef struct __attribute__((packed)) {
+  uint16_t azimuth_cdeg;          // 0.01 degree
+  uint16_t elevation_cdeg;
+} CmdManual_t;
+
+typedef struct __attribute__((packed)) {
+  uint16_t gain_milli[4];         // Kp, Ki, Kd, Kff x1000
+} CmdPid_t;
+
+typedef struct __attribute__((packed)) {
+  uint32_t time_ms;               // From trajectory start, strictly increasing
+  uint16_t azimuth_cdeg;          // 0.01 degree
+  uint16_t elevation_cdeg;
+} CmdWaypoint_t;
+
+typedef struct __attribute__((packed)) {
+  uint8_t type;                   // CMD_ACK_TYPE
+  uint8_t version;                // CMD_PROTOCOL_VERSION
+  uint16_t request_id;            // From the request (0 if unreadable)
+  uint8_t status;                 // CMD_STATUS_OK, or why nothing ran
+  uint8_t count;                  // Status bytes that follow, one per command
+} CmdAckHeader_t;
+
+#define CMD_MAX_ACK_PAYLOAD  (sizeof(CmdAckHeader_t) + CMD_MAX_BATCH + sizeof(uint16_t))
+
+#endif // PROTOCOL_H
\ No newline at end of file
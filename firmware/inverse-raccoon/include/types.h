@@ -6,7 +6,26 @@
 #ifndef TYPES_H
 #define TYPES_H
 
+#ifdef ARDUINO
 #include <Arduino.h>
+#else
+// Host test build: only the standard integer types are needed here
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#endif
+#include "config.h"
+#include "utils/fixed.h"
+
+/**
+ * @brief Angle in degrees, Q9.6 (1/64 degree steps, +/-511 degrees)
+ */
+typedef Fixed<6> Angle_t;
+
+/**
+ * @brief Dimensionless gain / scale factor, Q1.14 (+/-2.0)
+ */
+typedef Fixed<14> Gain_t;
 
 // ============================================================================
 // SYSTEM TYPES
@@ -38,6 +57,28 @@ typedef enum {
   ERR_COUNT  // Must be last
 } ErrorCode_t;
 
+/**
+ * @brief Photoresistor channels (quadrants)
+ */
+typedef enum {
+  SENSOR_CH_TOPLEFT = 0,
+  SENSOR_CH_TOPRIGHT,
+  SENSOR_CH_BOTTOMLEFT,
+  SENSOR_CH_BOTTOMRIGHT,
+  SENSOR_CH_COUNT  // Must be last
+} SensorChannel_t;
+
+/**
+ * @brief Per-channel health verdict
+ */
+typedef enum {
+  SENSOR_HEALTH_OK = 0,
+  SENSOR_HEALTH_STUCK,         // Frozen while the other channels move
+  SENSOR_HEALTH_RANGE,         // Pinned at a rail the others are not at
+  SENSOR_HEALTH_RATE,          // Jumped while the other channels held still
+  SENSOR_HEALTH_INCONSISTENT   // Breaks the quadrant cross-product balance
+} SensorHealth_t;
+
 /**
  * @brief Sensor reading structure
  */
@@ -47,24 +88,66 @@ typedef struct {
   uint16_t bottom_left;
   uint16_t bottom_right;
   uint32_t timestamp;
+  uint8_t resolution_bits;  // Bits per value (10 + oversampling bits)
+  uint8_t healthy_mask;     // Bit n set = SensorChannel_t n is trusted
   bool valid;
 } SensorReading_t;
 
+/**
+ * @brief Generation-stamped sensor snapshot
+ *
+ * Acquired once per control cycle and shared read-only by tracking,
+ * safety and telemetry.
+ */
+typedef struct {
+  SensorReading_t reading;
+  uint32_t generation;
+} SensorSnapshot_t;
+
 /**
  * @brief Sun position error vector
  */
 typedef struct {
-  float azimuth_error;
-  float elevation_error;
+  Angle_t azimuth_error;
+  Angle_t elevation_error;
   bool sun_detected;
 } SunPosition_t;
 
 /**
- * @brief Servo command with CRC
+ * @brief Tracking controller gains (Q1.14, each < 2.0)
+ */
+typedef struct {
+  Gain_t kp;    // Proportional
+  Gain_t ki;    // Integral (per cycle)
+  Gain_t kd;    // Derivative (per cycle)
+  Gain_t kff;   // Sun-rate feedforward
+} TrackingGains_t;
+
+/**
+ * @brief Servo axes
+ */
+typedef enum {
+  SERVO_AXIS_AZIMUTH = 0,
+  SERVO_AXIS_ELEVATION,
+  SERVO_AXIS_COUNT  // Must be last
+} ServoAxis_t;
+
+/**
+ * @brief Servo duty-cycle and energy accounting since boot
+ */
+typedef struct {
+  uint32_t elapsed_ms;
+  uint32_t attached_ms[SERVO_AXIS_COUNT];
+  uint32_t charge_mas;     // Estimated servo charge, mA*s
+  uint8_t attached_mask;   // Bit per ServoAxis_t
+} ServoPowerStats_t;
+
+/**
+ * @brief Servo command with CRC (positions in 0.01 degree)
  */
 typedef struct __attribute__((packed)) {
-  uint16_t azimuth;
-  uint16_t elevation;
+  uint16_t azimuth_cdeg;
+  uint16_t elevation_cdeg;
   uint16_t crc16;
 } ServoCommand_t;
 
@@ -78,6 +161,17 @@ typedef struct __attribute__((packed)) {
   uint16_t servo_elevation_offset;
   uint16_t error_counts[ERR_COUNT];
   uint32_t boot_count;
+  uint16_t sensor_cal[SENSOR_CH_COUNT][SENSOR_CAL_KNOTS];  // Knot outputs, 16-bit scale
+  int16_t site_latitude_cdeg;     // North positive, 0.01 deg
+  int16_t site_longitude_cdeg;    // East positive, 0.01 deg
+  int16_t mount_azimuth_deg;      // Compass bearing of servo azimuth 90
+  uint8_t site_valid;
+  uint16_t servo_min_us[SERVO_AXIS_COUNT];   // Pulse width at 0 degrees
+  uint16_t servo_max_us[SERVO_AXIS_COUNT];   // Pulse width at 180 degrees
+  uint16_t servo_max_speed[SERVO_AXIS_COUNT];  // 0.01 deg/s, 0 = unlimited
+  uint16_t servo_max_accel[SERVO_AXIS_COUNT];  // 0.01 deg/s^2, 0 = unlimited
+  uint16_t telemetry_period_ms;
+  uint8_t telemetry_groups;       // TELEM_GROUP_* subscription
   uint16_t crc16;
 } Config_t;
 
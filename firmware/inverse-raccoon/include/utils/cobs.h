@@ -0,0 +1,37 @@
+/**
+ * @file cobs.h
+ * @brief Consistent Overhead Byte Stuffing (zero-free framing)
+ */
+
+#ifndef COBS_H
+#define COBS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Worst-case encoded size for a payload of n bytes
+ */
+#define COBS_MAX_ENCODED(n)  ((n) + (n) / 254 + 1)
+
+/**
+ * @brief Encode a buffer so that it contains no zero bytes
+ * @param src Payload
+ * @param length Payload size
+ * @param dst Output, at least COBS_MAX_ENCODED(length) bytes. May overlap
+ *            src if it starts COBS_MAX_ENCODED(length) - length or more
+ *            bytes before it: each byte is read before it is overwritten.
+ * @return Encoded size (delimiter not included)
+ */
+size_t cobs_encode(const uint8_t* src, size_t length, uint8_t* dst);
+
+/**
+ * @brief Decode one COBS block (without its delimiter)
+ * @param src Encoded bytes
+ * @param length Encoded size
+ * @param dst Output, at least length bytes
+ * @return Decoded size, or 0 if the block is malformed
+ */
+size_t cobs_decode(const uint8_t* src, size_t length, uint8_t* dst);
+
+#endif // COBS_H
\ No newline at end of file
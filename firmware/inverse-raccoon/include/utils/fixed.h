@@ -0,0 +1,134 @@
+/**
+ * @file fixed.h
+ * @brief Saturating Q-format fixed-point arithmetic
+ */
+
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stdint.h>
+
+/**
+ * @brief Signed 16-bit Q-format fixed-point number
+ *
+ * Stores value * 2^FRAC in an int16_t. Every operation widens to int32_t
+ * and saturates back into range, so results clip instead of wrapping.
+ * Used on the sensor-to-tracking path; from_float() is meant for
+ * compile-time constants only.
+ *
+ * @tparam FRAC Number of fractional bits (0-14)
+ */
+template<uint8_t FRAC>
+class Fixed {
+  static_assert(FRAC <= 14, "Fixed supports at most 14 fractional bits");
+
+  template<uint8_t> friend class Fixed;
+
+private:
+  int16_t raw_;
+
+  constexpr Fixed(int16_t raw, bool) : raw_(raw) {}
+
+  /**
+   * @brief Clip a widened intermediate back into int16_t range
+   */
+  static constexpr int16_t saturate(int32_t v) {
+    return (v > INT16_MAX) ? INT16_MAX : ((v < INT16_MIN) ? INT16_MIN : (int16_t)v);
+  }
+
+public:
+  static const int16_t ONE = (int16_t)(1 << FRAC);
+
+  /**
+   * @brief Default constructor (zero)
+   */
+  constexpr Fixed() : raw_(0) {}
+
+  /**
+   * @brief Construct from raw Q-format bits (saturating)
+   */
+  static constexpr Fixed from_raw(int32_t raw) {
+    return Fixed(saturate(raw), true);
+  }
+
+  /**
+   * @brief Construct from an integer (saturating)
+   */
+  static constexpr Fixed from_int(int32_t v) {
+    return Fixed(saturate(v * ONE), true);
+  }
+
+  /**
+   * @brief Construct from a float constant
+   *
+   * Meant for config constants only: with a literal argument it folds at
+   * compile time and pulls in no floating-point code.
+   */
+  static constexpr Fixed from_float(float v) {
+    return Fixed(saturate((int32_t)(v * ONE + (v >= 0 ? 0.5f : -0.5f))), true);
+  }
+
+  /**
+   * @brief Integer times a fixed-point factor, e.g. ADC counts * scale
+   * @param n Integer operand, optionally carrying n_frac fractional bits
+   * @param k Factor in any Q format with at least FRAC fractional bits
+   * @param n_frac Fractional bits in n (e.g. extra oversampling bits)
+   */
+  template<uint8_t KFRAC>
+  static Fixed product(int32_t n, Fixed<KFRAC> k, uint8_t n_frac = 0) {
+    static_assert(KFRAC >= FRAC, "factor needs at least FRAC fractional bits");
+    return from_raw((n * k.raw_) >> (KFRAC - FRAC + n_frac));
+  }
+
+  /**
+   * @brief Raw Q-format bits
+   */
+  constexpr int16_t raw() const { return raw_; }
+
+  /**
+   * @brief Integer part, truncated toward zero
+   */
+  int16_t to_int() const { return raw_ / ONE; }
+
+  /**
+   * @brief Absolute value (saturating)
+   */
+  Fixed magnitude() const { return from_raw(raw_ < 0 ? -(int32_t)raw_ : raw_); }
+
+  /**
+   * @brief Clamp into [lo, hi]
+   */
+  Fixed clamp(Fixed lo, Fixed hi) const {
+    return (raw_ < lo.raw_) ? lo : ((raw_ > hi.raw_) ? hi : *this);
+  }
+
+  Fixed operator+(Fixed o) const { return from_raw((int32_t)raw_ + o.raw_); }
+  Fixed operator-(Fixed o) const { return from_raw((int32_t)raw_ - o.raw_); }
+  Fixed operator-() const { return from_raw(-(int32_t)raw_); }
+  Fixed operator*(int16_t n) const { return from_raw((int32_t)raw_ * n); }
+  Fixed operator/(int16_t n) const { return from_raw((int32_t)raw_ / n); }
+
+  /**
+   * @brief Multiply by a factor in another Q format, rounding to nearest
+   */
+  template<uint8_t KFRAC>
+  Fixed operator*(Fixed<KFRAC> k) const {
+    int32_t p = (int32_t)raw_ * k.raw_;
+    if (KFRAC > 0) {
+      p += (int32_t)1 << (KFRAC > 0 ? KFRAC - 1 : 0);
+    }
+    return from_raw(p >> KFRAC);
+  }
+
+  Fixed& operator+=(Fixed o) { *this = *this + o; return *this; }
+  Fixed& operator-=(Fixed o) { *this = *this - o; return *this; }
+
+  bool operator==(Fixed o) const { return raw_ == o.raw_; }
+  bool operator!=(Fixed o) const { return raw_ != o.raw_; }
+  bool operator<(Fixed o) const { return raw_ < o.raw_; }
+  bool operator>(Fixed o) const { return raw_ > o.raw_; }
+  bool operator<=(Fixed o) const { return raw_ <= o.raw_; }
+  bool operator>=(Fixed o) const { return raw_ >= o.raw_; }
+};
+
+#endif // FIXED_H
@@ -0,0 +1,55 @@
+/**
+ * @file pid.h
+ * @brief Incremental PID + sun-rate feedforward law for one tracking axis
+ *
+ * Each call returns a position increment:
+ *   step = Kp*e + Ki*sum(e) + Kd*de/dt (filtered) + Kff*sun_rate
+ * where sun_rate is the slope of (commanded angle + error) over the last
+ * SUN_RATE_HISTORY cycles. With Ki = Kd = Kff = 0 this is the original
+ * proportional step controller. The error sum is cleared when the error
+ * changes sign, so it cannot carry a step past the sun.
+ */
+
+#ifndef PID_H
+#define PID_H
+
+#include "types.h"
+
+/**
+ * @brief Per-axis controller state
+ */
+typedef struct {
+  int32_t integral;                        // Error sum, Angle_t raw units
+  Angle_t prev_error;
+  Angle_t derivative;                      // Filtered error change per cycle
+  Angle_t sun_history[SUN_RATE_HISTORY];   // Estimated sun angle per cycle
+  uint8_t history_index;
+  uint8_t history_count;
+} PidAxis_t;
+
+/**
+ * @brief Forget integral, derivative and rate history
+ */
+void pid_reset(PidAxis_t* axis);
+
+/**
+ * @brief Skip an update (servo still moving) without a derivative kick
+ * @param axis Controller state
+ * @param error Pointing error this cycle
+ */
+void pid_hold(PidAxis_t* axis, Angle_t error);
+
+/**
+ * @brief One PID + feedforward step
+ * @param axis Controller state
+ * @param gains Gain set
+ * @param error Pointing error this cycle
+ * @param position Current commanded angle
+ * @param lo Lower travel limit
+ * @param hi Upper travel limit
+ * @return Position increment to apply
+ */
+Angle_t pid_update(PidAxis_t* axis, const TrackingGains_t* gains, Angle_t error,
+                   Angle_t position, Angle_t lo, Angle_t hi);
+
+#endif // PID_H
\ No newline at end of file
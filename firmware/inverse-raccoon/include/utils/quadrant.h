@@ -0,0 +1,47 @@
+/**
+ * @file quadrant.h
+ * @brief Cross-channel consistency check for the four-quadrant sun sensor
+ */
+
+#ifndef QUADRANT_H
+#define QUADRANT_H
+
+#include <stdint.h>
+
+// Quadrant order, matching SENSOR_CH_* in types.h
+#define QUADRANT_TOPLEFT      0
+#define QUADRANT_TOPRIGHT     1
+#define QUADRANT_BOTTOMLEFT   2
+#define QUADRANT_BOTTOMRIGHT  3
+#define QUADRANT_COUNT        4
+
+/**
+ * @brief Whether the three brightest quadrants read alike
+ *
+ * Holds when the head is pointed at the sun or the scene is evenly lit,
+ * even with one channel reading low. Off-pointing leaves at most two
+ * bright quadrants alike. Three alike and dark with one bright corner is
+ * not accepted: that is what the sun far off along a diagonal looks like.
+ *
+ * @param v 10-bit values
+ * @param spread_pct Largest spread among the three, as % of the brightest
+ */
+bool quadrant_is_pointed(const uint16_t v[QUADRANT_COUNT], uint8_t spread_pct);
+
+/**
+ * @brief Pick the channel that breaks the quadrant cross-product balance
+ *
+ * For any separable light field TL*BR == TR*BL, but the shading of an
+ * off-pointed sensor head is not separable: with the sun off along a
+ * diagonal one corner is lit and the opposite one shadowed, and the
+ * products disagree although every cell is fine. The check therefore
+ * only runs while quadrant_is_pointed() holds, which also means it catches
+ * channels reading low but not a lone channel reading high (a shorted
+ * cell still fails the rail check).
+ *
+ * @param v 10-bit values
+ * @return Suspect channel, or QUADRANT_COUNT if consistent (or not checked)
+ */
+uint8_t quadrant_find_inconsistent(const uint16_t v[QUADRANT_COUNT]);
+
+#endif // QUADRANT_H
\ No newline at end of file
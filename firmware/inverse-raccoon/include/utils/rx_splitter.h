@@ -0,0 +1,66 @@
+/**
+ * @file rx_splitter.h
+ * @brief Splits a serial byte stream into text lines and COBS frames
+ *
+ * Text commands end at '\n' or '\r'; binary frames sit between two 0x00
+ * delimiters. Both share one caller-owned buffer, and every byte takes
+ * exactly one of the two paths.
+ */
+
+#ifndef RX_SPLITTER_H
+#define RX_SPLITTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief What a received byte completed
+ */
+typedef enum {
+  RX_PENDING = 0,     // Nothing complete yet
+  RX_LINE,            // buffer holds a NUL-terminated text line
+  RX_FRAME,           // buffer holds length encoded frame bytes
+  RX_BAD_FRAME,       // A frame overran frame_limit and was dropped
+  RX_LINE_TOO_LONG    // A text line overran the buffer and was dropped
+} RxEvent_t;
+
+/**
+ * @brief Receiver state (treat as opaque, except buffer and length)
+ */
+typedef struct {
+  char* buffer;
+  uint8_t size;         // Buffer size; text lines keep one byte for the NUL
+  uint8_t frame_limit;  // Largest encoded frame accepted
+  uint16_t timeout_ms;  // Gap after which a partial frame is abandoned
+  uint8_t index;
+  uint8_t length;       // Size of the last completed line or frame
+  bool in_frame;
+  bool overflow;
+  uint32_t last_ms;
+} RxSplitter_t;
+
+/**
+ * @brief Attach a buffer and reset the receiver
+ * @param rx Receiver
+ * @param buffer Storage, at least frame_limit bytes
+ * @param size Buffer size
+ * @param frame_limit Largest encoded frame accepted
+ * @param timeout_ms A frame arrives in one burst; a longer gap drops it
+ */
+void rx_splitter_init(RxSplitter_t* rx, char* buffer, uint8_t size,
+                      uint8_t frame_limit, uint16_t timeout_ms);
+
+/**
+ * @brief Feed one received byte
+ *
+ * On RX_LINE or RX_FRAME the buffer holds the result, rx->length bytes
+ * long, until the next call.
+ *
+ * @param rx Receiver
+ * @param c Received byte
+ * @param now_ms Current time
+ * @return Event completed by this byte
+ */
+RxEvent_t rx_splitter_feed(RxSplitter_t* rx, char c, uint32_t now_ms);
+
+#endif // RX_SPLITTER_H
\ No newline at end of file
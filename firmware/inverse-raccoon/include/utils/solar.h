@@ -0,0 +1,46 @@
+/**
+ * @file solar.h
+ * @brief Fixed-point NOAA solar position (no Arduino dependencies)
+ */
+
+#ifndef SOLAR_H
+#define SOLAR_H
+
+#include "types.h"
+
+/**
+ * @brief Sun direction as seen from the site
+ */
+typedef struct {
+  Angle_t azimuth;     // Degrees clockwise from true north (0-360)
+  Angle_t elevation;   // Degrees above the horizon (-90..90)
+} SolarPosition_t;
+
+/**
+ * @brief Split days since 1970-01-01 into day of year and year length
+ *
+ * Loop-free (one 32-bit and one 16-bit division), so the cost does not
+ * grow with the date. Valid over the whole uint32_t Unix range (to 2106).
+ *
+ * @param unix_days Days since 1970-01-01
+ * @param days_in_year Output: 365 or 366
+ * @return Day of year, 0 = 1 January
+ */
+uint16_t solar_day_of_year(uint32_t unix_days, uint16_t* days_in_year);
+
+/**
+ * @brief Compute sun position for a given time and site
+ *
+ * NOAA general solar position equations (fractional-year Fourier series
+ * for declination and equation of time) evaluated entirely in integer
+ * arithmetic with PROGMEM trig tables. Refraction is not modelled.
+ *
+ * @param unix_seconds UTC time
+ * @param latitude_cdeg Site latitude, north positive, 0.01 deg
+ * @param longitude_cdeg Site longitude, east positive, 0.01 deg
+ * @param position Output sun direction
+ */
+void solar_position(uint32_t unix_seconds, int16_t latitude_cdeg, int16_t longitude_cdeg,
+                    SolarPosition_t* position);
+
+#endif // SOLAR_H
\ No newline at end of file
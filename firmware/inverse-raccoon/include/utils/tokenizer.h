@@ -0,0 +1,46 @@
+/**
+ * @file tokenizer.h
+ * @brief In-place command line tokenizer and integer parsing
+ *
+ * Tokens are split by writing terminators into the caller's buffer, so
+ * nothing is copied or allocated. Replaces sscanf(), whose vfscanf costs
+ * several KB of flash.
+ */
+
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Split off the next space- or comma-separated token
+ * @param cursor Read position, advanced past the token
+ * @return Token, or NULL at the end of the line
+ */
+char* token_next(char** cursor);
+
+/**
+ * @brief Take everything left on the line, without surrounding separators
+ * @param cursor Read position, advanced to the end of the line
+ * @return Remainder, or NULL if only separators are left
+ */
+char* token_rest(char** cursor);
+
+/**
+ * @brief Parse an unsigned decimal token
+ * @param token Digits only
+ * @param value Output
+ * @return false on an empty token, a non-digit or overflow
+ */
+bool token_to_uint(const char* token, uint32_t* value);
+
+/**
+ * @brief Parse a decimal token with an optional leading '-'
+ * @param token Text to parse
+ * @param value Output
+ * @return false on an empty token, a non-digit or overflow
+ */
+bool token_to_int(const char* token, int32_t* value);
+
+#endif // TOKENIZER_H
\ No newline at end of file
@@ -0,0 +1,48 @@
+/**
+ * @file trig.h
+ * @brief Fixed-point trigonometry on binary angles (PROGMEM tables)
+ */
+
+#ifndef TRIG_H
+#define TRIG_H
+
+#include <stdint.h>
+
+/**
+ * @brief Binary angle: full turn = 65536, so wrap-around is free
+ */
+typedef uint16_t BinaryAngle_t;
+
+#define BAM_PER_TURN     65536UL
+#define BAM_QUARTER_TURN 16384U
+
+/**
+ * @brief Sine of a binary angle
+ * @param angle Binary angle
+ * @return sin(angle) in Q15 (-32767..32767)
+ */
+int16_t trig_sin(BinaryAngle_t angle);
+
+/**
+ * @brief Cosine of a binary angle
+ * @param angle Binary angle
+ * @return cos(angle) in Q15 (-32767..32767)
+ */
+int16_t trig_cos(BinaryAngle_t angle);
+
+/**
+ * @brief Four-quadrant arctangent
+ * @param y Y component (any consistent scale)
+ * @param x X component
+ * @return Binary angle of (x, y); 0 for (0, 0)
+ */
+BinaryAngle_t trig_atan2(int32_t y, int32_t x);
+
+/**
+ * @brief Integer square root (floor)
+ * @param value Input
+ * @return floor(sqrt(value))
+ */
+uint16_t trig_isqrt(uint32_t value);
+
+#endif // TRIG_H
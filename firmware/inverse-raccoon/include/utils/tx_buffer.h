@@ -0,0 +1,75 @@
+/**
+ * @file tx_buffer.h
+ * @brief Print sink that holds a block of serial output and hands it to the
+ *        UART without blocking
+ */
+
+#ifndef TX_BUFFER_H
+#define TX_BUFFER_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Fixed-size staging buffer for serial output
+ *
+ * Fill it through the Print interface, then call drain() until it returns
+ * true. Bytes past the end set the overflow flag rather than being dropped
+ * silently.
+ *
+ * @tparam SIZE Capacity in bytes
+ */
+template<uint16_t SIZE>
+class TxBuffer : public Print {
+public:
+  TxBuffer() : length(0), sent(0), overflow(false) {}
+  
+  virtual size_t write(uint8_t byte) {
+    if (length >= SIZE) {
+      overflow = true;
+      return 0;
+    }
+    data[length++] = byte;
+    return 1;
+  }
+  
+  /**
+   * @brief Discard the contents
+   */
+  void clear() {
+    length = 0;
+    sent = 0;
+    overflow = false;
+  }
+  
+  /**
+   * @brief true once every byte has been handed to the port
+   */
+  bool empty() const {
+    return sent >= length;
+  }
+  
+  /**
+   * @brief Write as much as the port's TX ring accepts right now
+   * @return true once everything has been sent
+   */
+  bool drain(HardwareSerial& port) {
+    int room = port.availableForWrite();
+    uint16_t chunk = length - sent;
+    if (room <= 0 || chunk == 0) {
+      return empty();
+    }
+    if (chunk > (uint16_t)room) {
+      chunk = (uint16_t)room;
+    }
+    port.write(&data[sent], chunk);
+    sent += chunk;
+    return empty();
+  }
+  
+  uint8_t data[SIZE];
+  uint16_t length;
+  uint16_t sent;
+  bool overflow;
+};
+
+#endif // TX_BUFFER_H
\ No newline at end of file
@@ -16,21 +16,77 @@
 #include "modules/safety_manager.h"
 #include "modules/telemetry.h"
 #include "modules/command_handler.h"
+#include "modules/ephemeris.h"
+#include "modules/scheduler.h"
+#include "modules/control_timer.h"
+#include "modules/profiler.h"
+#include "modules/flight_recorder.h"
+#include "modules/journal.h"
+#include "modules/trajectory.h"
+#include "modules/console.h"
 
-// Global timing variables
-static uint32_t g_loop_start_time;
-static uint32_t g_last_scrub_time;
-static uint32_t g_last_telemetry_time;
-static uint32_t g_last_config_save_time;
-static uint32_t g_last_error_reset_time;
 static uint16_t g_flow_signature;
+static ServoCommand_t g_servo_cmd;
+static uint32_t g_last_config_save;
 
-// Telemetry intervals
-#define TELEMETRY_INTERVAL_MS  1000
+// Task periods
+#define COMMAND_POLL_PERIOD_MS  10
+#define TELEMETRY_DRAIN_PERIOD_MS 5   // 64-byte UART ring empties in 5.6 ms at 115200
 #define CONFIG_SAVE_INTERVAL_MS 60000
+#define CONFIG_SAVE_STEP_PERIOD_MS 4   // At most one EEPROM write per step (3.3 ms each)
 #define ERROR_RESET_INTERVAL_MS 30000
 
+// Task worst-case budgets (us)
+#define CONTROL_BUDGET_US       (CONTROL_LOOP_PERIOD_MS * 500U)   // Half the period
+#define COMMAND_BUDGET_US       4000
+#define SCRUB_BUDGET_US         2000
+#define TELEMETRY_BUDGET_US     3000    // Stages the frame; sending is the drain task's
+#define TX_DRAIN_BUDGET_US      1500
+#define ERROR_RESET_BUDGET_US   1000
+#define JOURNAL_BUDGET_US       500     // One EEPROM.update(), never waits
+#define CONFIG_SAVE_BUDGET_US   500     // Compares CONFIG_SAVE_SCAN_BYTES, writes at most one
+
+static void control_task(uint32_t now);
+static void command_task(uint32_t now);
+static void scrub_task(uint32_t now);
+static void telemetry_task(uint32_t now);
+static void tx_drain_task(uint32_t now);
+static void error_reset_task(uint32_t now);
+static void config_save_task(uint32_t now);
+static void journal_task(uint32_t now);
+static void record_cycle(const SensorSnapshot_t* snapshot);
+static bool serial_tx_busy();
+
+static const char k_task_control[] PROGMEM = "control";
+static const char k_task_command[] PROGMEM = "command";
+static const char k_task_scrub[] PROGMEM = "scrub";
+static const char k_task_telemetry[] PROGMEM = "telemetry";
+static const char k_task_tx_drain[] PROGMEM = "tx_drain";
+static const char k_task_error_reset[] PROGMEM = "err_reset";
+static const char k_task_config_save[] PROGMEM = "cfg_save";
+static const char k_task_journal[] PROGMEM = "journal";
+
+// Static task table: control path first (released by the Timer2 tick),
+// background work fills the slack
+#define CONTROL_TASK_INDEX      0
+#define TELEMETRY_TASK_INDEX    3   // Period set at runtime (TELEM RATE)
+static const Task_t k_tasks[] PROGMEM = {
+  // name              run               trigger        period                       prio budget
+  { k_task_control,     control_task,     TASK_EVENT,    CONTROL_LOOP_PERIOD_MS,      0, CONTROL_BUDGET_US     },
+  { k_task_command,     command_task,     TASK_PERIODIC, COMMAND_POLL_PERIOD_MS,      1, COMMAND_BUDGET_US     },
+  { k_task_scrub,       scrub_task,       TASK_PERIODIC, SCRUB_INTERVAL_MS,           2, SCRUB_BUDGET_US       },
+  { k_task_telemetry,   telemetry_task,   TASK_PERIODIC, TELEMETRY_DEFAULT_PERIOD_MS, 3, TELEMETRY_BUDGET_US   },
+  { k_task_tx_drain,    tx_drain_task,    TASK_PERIODIC, TELEMETRY_DRAIN_PERIOD_MS,   3, TX_DRAIN_BUDGET_US    },
+  { k_task_error_reset, error_reset_task, TASK_PERIODIC, ERROR_RESET_INTERVAL_MS,     4, ERROR_RESET_BUDGET_US },
+  { k_task_config_save, config_save_task, TASK_PERIODIC, CONFIG_SAVE_STEP_PERIOD_MS,  5, CONFIG_SAVE_BUDGET_US },
+  { k_task_journal,     journal_task,     TASK_PERIODIC, JOURNAL_SERVICE_PERIOD_MS,   4, JOURNAL_BUDGET_US     },
+};
+
 void setup() {
+  // Reset cause, before anything can clear it
+  uint8_t reset_flags = MCUSR;
+  MCUSR = 0;
+  
   // Initialize telemetry first for debug output
   telemetry_init();
   
@@ -39,58 +95,68 @@ void setup() {
   
   // Safe boot and configuration
   config_manager_init();
+  journal_init(reset_flags);
   
   // Initialize all modules
   sensor_manager_init();
+  ephemeris_init();
   tracking_controller_init();
   servo_driver_init();
   safety_manager_init();
   command_handler_init();
-  
-  // Initialize timing
-  g_last_scrub_time = millis();
-  g_last_telemetry_time = millis();
-  g_last_config_save_time = millis();
-  g_last_error_reset_time = millis();
+  flight_recorder_init();
   
   Serial.println(F("[INIT] System ready\n"));
   delay(1000);
+  
+  // Start scheduling after the settle delay so nothing begins overdue
+  scheduler_init(k_tasks, sizeof(k_tasks) / sizeof(k_tasks[0]), millis());
+  g_last_config_save = millis();
+  control_timer_init(CONTROL_TASK_INDEX);
+  telemetry_start(TELEMETRY_TASK_INDEX);
 }
 
 void loop() {
-  g_loop_start_time = millis();
+  if (!scheduler_run()) {
+    scheduler_idle();
+  }
+}
+
+/**
+ * @brief Control path: sense, track, actuate, verify (highest priority)
+ */
+static void control_task(uint32_t now) {
+  (void)now;
+  control_timer_begin_cycle();
+  PROF_BEGIN(PROF_CONTROL);
   
   // Feed watchdog
   wdt_reset();
   
-  // Process incoming commands
-  command_handler_process();
+  // Single sensor acquisition per cycle, shared by control, safety and telemetry
+  PROF_BEGIN(PROF_SENSOR);
+  const SensorSnapshot_t* snapshot = sensor_acquire();
+  PROF_END(PROF_SENSOR);
   
   // Control flow check initialization
   g_flow_signature = SIG_INIT;
   
-  // Declare command structure
-  ServoCommand_t servo_cmd;
-  
   // Check control mode
   ControlMode_t control_mode = command_get_mode();
   
   if (control_mode == CONTROL_MANUAL) {
     // ===== MANUAL MODE =====
-    // Still read sensors for telemetry, but don't use for control
-    SensorReading_t sensor_data;
-    sensor_read_all(&sensor_data);
-    
+    // Sensors still acquired above for telemetry, but not used for control
     g_flow_signature ^= SIG_SENSOR;
     g_flow_signature ^= SIG_TRACKING;
     
     // Check for pending manual command
     if (command_has_pending()) {
-      command_get_pending(&servo_cmd);
+      command_get_pending(&g_servo_cmd);
       
       // Execute manual command
       if (safety_get_mode() != MODE_EMERGENCY) {
-        servo_execute_command(&servo_cmd);
+        servo_execute_command(&g_servo_cmd);
       }
     }
     // If no pending command, servos just hold their last position
@@ -98,65 +164,34 @@ void loop() {
     g_flow_signature ^= SIG_SERVO;
   } 
 
-  else if (control_mode == CONTROL_DEMO) {
-  // ===== DEMO MODE =====
-  // Simulate sun arc from sunrise to sunset
-  
-  uint32_t elapsed = millis() - command_get_demo_start_time();
-  float progress = (float)elapsed / 45000.0f;  // 45 second demo
-  
-  if (progress >= 1.0f) {
-    // Demo complete, return to auto mode
-    Serial.println(F("[DEMO] Arc complete - returning to AUTO mode"));
-    // This will switch mode on next command_handler_process call
-    Serial.println(F("AUTO"));  // Send AUTO command to switch modes
-    progress = 1.0f;
-  }
-  
-  // Simulate sun arc:
-  // Start: Az=60°, El=20° (sunrise in east)
-  // Peak:  Az=90°, El=70° (noon overhead)
-  // End:   Az=120°, El=20° (sunset in west)
-  
-  float azimuth, elevation;
-  
-  if (progress < 0.5f) {
-    // First half: sunrise to noon
-    float t = progress * 2.0f;  // 0 to 1
-    azimuth = 60.0f + (30.0f * t);      // 60° to 90°
-    elevation = 20.0f + (50.0f * t);    // 20° to 70°
-  } else {
-    // Second half: noon to sunset
-    float t = (progress - 0.5f) * 2.0f;  // 0 to 1
-    azimuth = 90.0f + (30.0f * t);      // 90° to 120°
-    elevation = 70.0f - (50.0f * t);    // 70° to 20°
-  }
-  
-  servo_cmd.azimuth = (uint16_t)azimuth;
-  servo_cmd.elevation = (uint16_t)elevation;
-  servo_cmd.crc16 = crc16(&servo_cmd, offsetof(ServoCommand_t, crc16));
-  
-  // Execute demo command
-  if (safety_get_mode() != MODE_EMERGENCY) {
-    servo_execute_command(&servo_cmd);
+  else if (control_mode == CONTROL_TRAJECTORY) {
+    // ===== TRAJECTORY MODE =====
+    // Queued waypoints (WP commands or the DEMO arc), interpolated each cycle
+    uint16_t azimuth_cdeg = g_servo_cmd.azimuth_cdeg;
+    uint16_t elevation_cdeg = g_servo_cmd.elevation_cdeg;
+    trajectory_tick(millis(), &azimuth_cdeg, &elevation_cdeg);
+    
+    g_servo_cmd.azimuth_cdeg = azimuth_cdeg;
+    g_servo_cmd.elevation_cdeg = elevation_cdeg;
+    g_servo_cmd.crc16 = crc16(&g_servo_cmd, offsetof(ServoCommand_t, crc16));
+    
+    if (safety_get_mode() != MODE_EMERGENCY) {
+      servo_execute_command(&g_servo_cmd);
+    }
+    
+    g_flow_signature ^= SIG_SENSOR;
+    g_flow_signature ^= SIG_TRACKING;
+    g_flow_signature ^= SIG_SERVO;
   }
-  
-  g_flow_signature ^= SIG_SENSOR;
-  g_flow_signature ^= SIG_TRACKING;
-  g_flow_signature ^= SIG_SERVO;
-  
-  // Read sensors for telemetry
-  SensorReading_t sensor_data;
-  sensor_read_all(&sensor_data);
-}
   else {
     // ===== AUTOMATIC MODE =====
     // Normal sun tracking operation
-    SensorReading_t sensor_data;
-    SunPosition_t sun_position;
+    SunPosition_t sun_position = {};
     
-    if (sensor_read_all(&sensor_data)) {
-      sensor_calculate_position(&sensor_data, &sun_position);
+    if (snapshot->reading.valid) {
+      PROF_BEGIN(PROF_POSITION);
+      sensor_calculate_position(&snapshot->reading, &sun_position);
+      PROF_END(PROF_POSITION);
       
       // Update sun detection time if sun is visible
       if (sun_position.sun_detected) {
@@ -167,74 +202,184 @@ void loop() {
     g_flow_signature ^= SIG_SENSOR;
     
     // Tracking algorithm
-    tracking_calculate_command(&sun_position, &servo_cmd);
+    PROF_BEGIN(PROF_TRACKING);
+    tracking_calculate_command(&sun_position, &g_servo_cmd);
+    PROF_END(PROF_TRACKING);
     
     g_flow_signature ^= SIG_TRACKING;
     
     // Servo control
     if (safety_get_mode() != MODE_EMERGENCY) {
-      servo_execute_command(&servo_cmd);
+      servo_execute_command(&g_servo_cmd);
     }
     
     g_flow_signature ^= SIG_SERVO;
   }
   
+  // Advance servo motion profiles toward the latched targets
+  PROF_BEGIN(PROF_SERVO);
+  servo_driver_tick(millis());
+  PROF_END(PROF_SERVO);
+  
   // Check control flow integrity
+  PROF_BEGIN(PROF_SAFETY);
   safety_verify_control_flow(g_flow_signature);
   
-  // Memory scrubbing
-  if (millis() - g_last_scrub_time >= SCRUB_INTERVAL_MS) {
-    safety_scrub_memory();
-    g_last_scrub_time = millis();
-  }
-  
   // Safety evaluation
   safety_evaluate_mode();
+  PROF_END(PROF_SAFETY);
   
   // Heartbeat LED
   telemetry_update_heartbeat();
   
-  // Telemetry output
-  if (millis() - g_last_telemetry_time >= TELEMETRY_INTERVAL_MS) {
-    // Read current sensor data for telemetry
-    SensorReading_t sensor_data;
-    sensor_read_all(&sensor_data);
-    
-    telemetry_print_json(&sensor_data, &servo_cmd);
-    
-    // Print control mode indicator
-    if (control_mode == CONTROL_MANUAL) {
-      Serial.println(F("[MODE] MANUAL"));
-    }
-    
-    g_last_telemetry_time = millis();
+  PROF_END(PROF_CONTROL);
+  control_timer_end_cycle();
+  
+  record_cycle(snapshot);
+}
+
+/**
+ * @brief Append this cycle to the flight recorder
+ */
+static void record_cycle(const SensorSnapshot_t* snapshot) {
+  const SensorReading_t* reading = &snapshot->reading;
+  uint8_t extra_bits = reading->resolution_bits - SENSOR_ADC_BITS;
+  const ControlTiming_t* timing = control_timer_get_stats();
+  
+  FlightSample_t sample;
+  sample.ldr[SENSOR_CH_TOPLEFT] = reading->top_left >> extra_bits;
+  sample.ldr[SENSOR_CH_TOPRIGHT] = reading->top_right >> extra_bits;
+  sample.ldr[SENSOR_CH_BOTTOMLEFT] = reading->bottom_left >> extra_bits;
+  sample.ldr[SENSOR_CH_BOTTOMRIGHT] = reading->bottom_right >> extra_bits;
+  sample.azimuth_cdeg = g_servo_cmd.azimuth_cdeg;
+  sample.elevation_cdeg = g_servo_cmd.elevation_cdeg;
+  sample.mode = (uint8_t)safety_get_mode();
+  sample.control_mode = (uint8_t)command_get_mode();
+  sample.healthy_mask = reading->healthy_mask;
+  sample.flags = (reading->valid ? FR_FLAG_VALID : 0) |
+                 (sensor_get_position()->sun_detected ? FR_FLAG_SUN : 0) |
+                 (servo_at_target() ? 0 : FR_FLAG_MOVING);
+  sample.sensor_errors = (uint8_t)min(sensor_get_error_count(), 0xFF);
+  sample.servo_errors = (uint8_t)min(servo_get_error_count(), 0xFF);
+  sample.exec_us = timing->last_exec_us;
+  sample.latency_us = timing->last_latency_us;
+  flight_recorder_log(&sample);
+}
+
+/**
+ * @brief Poll the serial command interface
+ */
+static void command_task(uint32_t now) {
+  (void)now;
+  
+  // Replies would land inside the telemetry frame or dump line being sent
+  if (serial_tx_busy()) {
+    return;
+  }
+  
+  PROF_BEGIN(PROF_COMMAND);
+  command_handler_process();
+  PROF_END(PROF_COMMAND);
+}
+
+/**
+ * @brief Memory scrubbing
+ */
+static void scrub_task(uint32_t now) {
+  (void)now;
+  PROF_BEGIN(PROF_SCRUB);
+  safety_scrub_memory();
+  PROF_END(PROF_SCRUB);
+}
+
+/**
+ * @brief Telemetry frame from the last control cycle's data
+ *
+ * Text goes out ahead of the frame: once staged, nothing else may write to
+ * Serial until the frame has drained.
+ */
+static void telemetry_task(uint32_t now) {
+  (void)now;
+  if (telemetry_is_busy()) {
+    telemetry_send(sensor_get_snapshot(), &g_servo_cmd);   // Counts the skip
+    return;
+  }
+  if (serial_tx_busy()) {
+    return;   // Telemetry pauses for the dump
   }
   
-  // Periodic config save
-  if (millis() - g_last_config_save_time >= CONFIG_SAVE_INTERVAL_MS) {
-    config_persist();
-    Serial.println(F("[CONFIG] Persisted to EEPROM"));
-    g_last_config_save_time = millis();
+  if (profiler_is_streaming()) {
+    profiler_print();
   }
   
-  // Error counter reset
-  if (millis() - g_last_error_reset_time >= ERROR_RESET_INTERVAL_MS) {
-    // Only reset if currently operating successfully
-    if (safety_get_mode() == MODE_NORMAL) {
-      sensor_reset_error_count();
-      servo_reset_error_count();
-      Serial.println(F("[SAFETY] Error counters cleared - recovery confirmed"));
-    }
-    g_last_error_reset_time = millis();
+  // Print control mode indicator (binary frames carry it in the header)
+  if (command_get_mode() == CONTROL_MANUAL &&
+      telemetry_get_format() == TELEMETRY_FORMAT_JSON) {
+    Serial.println(F("[MODE] MANUAL"));
+  }
+  
+  PROF_BEGIN(PROF_TELEMETRY);
+  telemetry_send(sensor_get_snapshot(), &g_servo_cmd);
+  PROF_END(PROF_TELEMETRY);
+}
+
+/**
+ * @brief Feed the staged telemetry frame, then any flight recorder or
+ *        journal dump, then queued console lines, to the UART without
+ *        blocking
+ */
+static void tx_drain_task(uint32_t now) {
+  (void)now;
+  telemetry_drain();
+  if (!telemetry_is_busy() && !flight_recorder_dump_step()) {
+    journal_dump_step();
+  }
+  if (!serial_tx_busy()) {
+    console_flush_step();
+  }
+}
+
+/**
+ * @brief true while a telemetry frame or dump owns the UART
+ */
+static bool serial_tx_busy() {
+  return telemetry_is_busy() || flight_recorder_is_dumping() || journal_is_dumping();
+}
+
+/**
+ * @brief Error counter reset, only if currently operating successfully
+ */
+static void error_reset_task(uint32_t now) {
+  (void)now;
+  if (safety_get_mode() == MODE_NORMAL) {
+    sensor_reset_error_count();
+    servo_reset_error_count();
+    console_post(F("[SAFETY] Error counters cleared - recovery confirmed"));
+  }
+}
+
+/**
+ * @brief Periodic config save, written in small steps that fit the slack
+ *        between higher-priority releases
+ */
+static void config_save_task(uint32_t now) {
+  if (now - g_last_config_save >= CONFIG_SAVE_INTERVAL_MS) {
+    g_last_config_save = now;
+    config_mark_dirty();   // Picks up the error counters
   }
   
-  // Maintain control loop timing
-  uint32_t elapsed = millis() - g_loop_start_time;
-  if (elapsed < CONTROL_LOOP_PERIOD_MS) {
-    delay(CONTROL_LOOP_PERIOD_MS - elapsed);
-  } else {
-    Serial.print(F("[WARNING] Control loop overrun: "));
-    Serial.print(elapsed);
-    Serial.println(F("ms"));
+  PROF_BEGIN(PROF_CONFIG_SAVE);
+  bool saved = config_save_step();
+  PROF_END(PROF_CONFIG_SAVE);
+  if (saved) {
+    console_post(F("[CONFIG] Persisted to EEPROM"));
   }
+}
+
+/**
+ * @brief Trickle queued journal records into EEPROM
+ */
+static void journal_task(uint32_t now) {
+  (void)now;
+  journal_service();
 }
\ No newline at end of file
@@ -4,165 +4,1139 @@
  */
 
 #include "modules/command_handler.h"
+#include "modules/sensor_manager.h"
+#include "modules/tracking_controller.h"
+#include "modules/ephemeris.h"
+#include "modules/config_manager.h"
+#include "modules/servo_driver.h"
+#include "modules/scheduler.h"
+#include "modules/control_timer.h"
+#include "modules/profiler.h"
+#include "modules/telemetry.h"
+#include "modules/flight_recorder.h"
+#include "modules/journal.h"
+#include "modules/safety_manager.h"
+#include "modules/trajectory.h"
 #include "config.h"
+#include "protocol.h"
 #include "utils/crc.h"
+#include "utils/cobs.h"
+#include "utils/tokenizer.h"
+#include "utils/rx_splitter.h"
 #include <Arduino.h>
 #include <string.h>
 
-// Command buffer
+// Command buffer (a text line, or a binary frame while one is open)
 static char g_cmd_buffer[CMD_BUFFER_SIZE];
-static uint8_t g_cmd_index = 0;
+static RxSplitter_t g_rx;
+
+static_assert(CMD_BUFFER_SIZE >= CMD_MAX_ENCODED, "command buffer cannot hold a binary frame");
 
 // Module state
 static ControlMode_t g_control_mode = CONTROL_AUTO;
 static ServoCommand_t g_pending_command;
 static bool g_has_pending = false;
-static uint32_t g_demo_start_time = 0;
-static const uint32_t DEMO_DURATION_MS = 45000;
+
+// DEMO arc: sunrise in the east, noon overhead, sunset in the west
+static const Waypoint_t k_demo_arc[] PROGMEM = {
+  // time_ms  azimuth_cdeg  elevation_cdeg
+  {     0,     6000,         2000 },
+  { 22500,     9000,         7000 },
+  { 45000,    12000,         2000 },
+};
+
+// TELEM FIELDS names, indexed by TELEM_GROUP_* bit position
+static const char k_field_sensors[] PROGMEM = "SENSORS";
+static const char k_field_sun[] PROGMEM = "SUN";
+static const char k_field_servos[] PROGMEM = "SERVOS";
+static const char k_field_power[] PROGMEM = "POWER";
+static const char k_field_timing[] PROGMEM = "TIMING";
+static const char k_field_errors[] PROGMEM = "ERRORS";
+static const char k_field_health[] PROGMEM = "HEALTH";
+
+static const char* const k_field_names[] PROGMEM = {
+  k_field_sensors,
+  k_field_sun,
+  k_field_servos,
+  k_field_power,
+  k_field_timing,
+  k_field_errors,
+  k_field_health
+};
+
+#define TELEM_FIELD_COUNT  (sizeof(k_field_names) / sizeof(k_field_names[0]))
+
+static_assert(TELEM_GROUP_ALL == (1 << TELEM_FIELD_COUNT) - 1, "TELEM FIELDS names out of step with protocol.h");
 
 /**
- * @brief Parse and execute a command string
+ * @brief Parse ALL, NONE or a space/comma separated list of field groups
+ * @param args Argument text (tokenized in place)
+ * @param groups Output TELEM_GROUP_* mask
+ * @return false on an unknown name
  */
-static void command_parse(const char* cmd) {
-  // Input validation
-  if (cmd == NULL) {
+static bool parse_telemetry_fields(char* args, uint8_t* groups) {
+  if (strcmp_P(args, PSTR("ALL")) == 0) {
+    *groups = TELEM_GROUP_ALL;
+    return true;
+  }
+  if (strcmp_P(args, PSTR("NONE")) == 0) {
+    *groups = 0;
+    return true;
+  }
+  
+  uint8_t mask = 0;
+  char* name;
+  while ((name = token_next(&args)) != NULL) {
+    uint8_t field;
+    for (field = 0; field < TELEM_FIELD_COUNT; field++) {
+      if (strcmp_P(name, (PGM_P)pgm_read_ptr(&k_field_names[field])) == 0) {
+        break;
+      }
+    }
+    if (field == TELEM_FIELD_COUNT) {
+      return false;
+    }
+    mask |= (1 << field);
+  }
+  
+  *groups = mask;
+  return true;
+}
+
+// ============================================================================
+// COMMAND TABLE
+// ============================================================================
+
+struct Command_t;
+
+/**
+ * @brief Arguments of one command line, checked against the entry's schema
+ */
+typedef struct {
+  uint8_t count;
+  char* text[CMD_MAX_ARGS];      // Tokens as typed (point into the line buffer)
+  int32_t value[CMD_MAX_ARGS];   // Parsed 'i' and 'u' arguments
+  const Command_t* command;      // PROGMEM entry, for the usage line
+} CommandArgs_t;
+
+typedef void (*CommandRun_t)(const CommandArgs_t* args);
+
+/**
+ * @brief Command table entry (PROGMEM)
+ *
+ * Argument schema, one character per argument:
+ *   i  signed decimal      u  unsigned decimal (32-bit)
+ *   w  word                *  rest of the line
+ *   [  arguments after this may be left off
+ */
+struct Command_t {
+  PGM_P synopsis;                // Name, then argument summary for HELP
+  PGM_P args;
+  PGM_P help;
+  CommandRun_t run;
+};
+
+#define HELP_SYNOPSIS_WIDTH  16
+
+/**
+ * @brief Print "[CMD] Usage: <synopsis>"
+ */
+static void print_usage(const CommandArgs_t* args) {
+  Serial.print(F("[CMD] Usage: "));
+  Serial.println((const __FlashStringHelper*)pgm_read_ptr(&args->command->synopsis));
+}
+
+/**
+ * @brief Map an AZ/EL word to its servo axis
+ */
+static bool parse_axis(const char* word, uint8_t* axis) {
+  if (strcmp_P(word, PSTR("AZ")) == 0) {
+    *axis = SERVO_AXIS_AZIMUTH;
+  } else if (strcmp_P(word, PSTR("EL")) == 0) {
+    *axis = SERVO_AXIS_ELEVATION;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+static void print_position_ranges() {
+  Serial.print(F("Az["));
+  Serial.print(MIN_AZIMUTH_DEG);
+  Serial.print(F("-"));
+  Serial.print(MAX_AZIMUTH_DEG);
+  Serial.print(F("] El["));
+  Serial.print(MIN_ELEVATION_DEG);
+  Serial.print(F("-"));
+  Serial.print(MAX_ELEVATION_DEG);
+  Serial.println(F("]"));
+}
+
+// ============================================================================
+// ACTIONS (shared by text and binary commands)
+// ============================================================================
+
+/**
+ * @brief Latch a servo position for the control task
+ */
+static void latch_position(uint16_t azimuth_cdeg, uint16_t elevation_cdeg) {
+  g_pending_command.azimuth_cdeg = azimuth_cdeg;
+  g_pending_command.elevation_cdeg = elevation_cdeg;
+  g_pending_command.crc16 = crc16(&g_pending_command, 
+                                  offsetof(ServoCommand_t, crc16));
+  g_has_pending = true;
+}
+
+/**
+ * @brief Change control mode; leaving trajectory mode abandons the trajectory
+ */
+static void set_control_mode(ControlMode_t mode) {
+  if (g_control_mode == CONTROL_TRAJECTORY && mode != CONTROL_TRAJECTORY) {
+    trajectory_clear();
+  }
+  g_control_mode = mode;
+}
+
+/**
+ * @brief Switch to manual control at a position
+ * @return false if outside the valid range (nothing changes)
+ */
+static bool action_manual(int32_t azimuth_cdeg, int32_t elevation_cdeg) {
+  if (azimuth_cdeg < MIN_AZIMUTH_DEG * (int32_t)SERVO_CDEG_PER_DEG ||
+      azimuth_cdeg > MAX_AZIMUTH_DEG * (int32_t)SERVO_CDEG_PER_DEG ||
+      elevation_cdeg < MIN_ELEVATION_DEG * (int32_t)SERVO_CDEG_PER_DEG ||
+      elevation_cdeg > MAX_ELEVATION_DEG * (int32_t)SERVO_CDEG_PER_DEG) {
+    return false;
+  }
+  set_control_mode(CONTROL_MANUAL);
+  latch_position(azimuth_cdeg, elevation_cdeg);
+  return true;
+}
+
+static void action_auto() {
+  set_control_mode(CONTROL_AUTO);
+  g_has_pending = false;
+}
+
+static void action_home() {
+  set_control_mode(CONTROL_MANUAL);
+  latch_position(DEFAULT_AZIMUTH_DEG * SERVO_CDEG_PER_DEG,
+                 DEFAULT_ELEVATION_DEG * SERVO_CDEG_PER_DEG);
+}
+
+/**
+ * @brief Run the queued waypoints from the current position
+ * @return false if a trajectory is already running (WP CLEAR first)
+ */
+static bool action_trajectory_start() {
+  if (!trajectory_start()) {
+    return false;
+  }
+  set_control_mode(CONTROL_TRAJECTORY);
+  g_has_pending = false;
+  return true;
+}
+
+/**
+ * @brief Replace the queue with the demo arc and run it
+ */
+static void action_demo() {
+  trajectory_clear();
+  for (uint8_t i = 0; i < sizeof(k_demo_arc) / sizeof(k_demo_arc[0]); i++) {
+    Waypoint_t point;
+    memcpy_P(&point, &k_demo_arc[i], sizeof(point));
+    trajectory_add(&point);
+  }
+  trajectory_end();
+  action_trajectory_start();
+}
+
+/**
+ * @brief Set the tracking gains from thousandths
+ * @return false if any gain is out of range (nothing changes)
+ */
+static bool action_pid(const int32_t gain_milli[4]) {
+  for (uint8_t i = 0; i < 4; i++) {
+    if (gain_milli[i] < 0 || gain_milli[i] > PID_GAIN_MAX_MILLI) {
+      return false;
+    }
+  }
+  TrackingGains_t gains;
+  gains.kp = Gain_t::from_raw((gain_milli[0] * Gain_t::ONE) / 1000);
+  gains.ki = Gain_t::from_raw((gain_milli[1] * Gain_t::ONE) / 1000);
+  gains.kd = Gain_t::from_raw((gain_milli[2] * Gain_t::ONE) / 1000);
+  gains.kff = Gain_t::from_raw((gain_milli[3] * Gain_t::ONE) / 1000);
+  tracking_set_gains(&gains);
+  return true;
+}
+
+// ============================================================================
+// TEXT COMMANDS
+// ============================================================================
+
+// MANUAL <azimuth> <elevation>
+static void cmd_manual(const CommandArgs_t* args) {
+  int32_t az = args->value[0];
+  int32_t el = args->value[1];
+  
+  // Degrees in, so the range check cannot overflow the 0.01 degree scale
+  if (az < MIN_AZIMUTH_DEG || az > MAX_AZIMUTH_DEG ||
+      el < MIN_ELEVATION_DEG || el > MAX_ELEVATION_DEG ||
+      !action_manual(az * SERVO_CDEG_PER_DEG, el * SERVO_CDEG_PER_DEG)) {
+    Serial.println(F("[CMD] Error: Position out of range"));
+    Serial.print(F("  Valid: "));
+    print_position_ranges();
+    return;
+  }
+  
+  Serial.print(F("[CMD] Manual mode - Az: "));
+  Serial.print(az);
+  Serial.print(F("° El: "));
+  Serial.print(el);
+  Serial.println(F("°"));
+}
+
+// AUTO
+static void cmd_auto(const CommandArgs_t* args) {
+  (void)args;
+  action_auto();
+  Serial.println(F("[CMD] Automatic tracking mode"));
+}
+
+// HOME
+static void cmd_home(const CommandArgs_t* args) {
+  (void)args;
+  action_home();
+  Serial.println(F("[CMD] Moving to home position"));
+}
+
+// DEMO
+static void cmd_demo(const CommandArgs_t* args) {
+  (void)args;
+  action_demo();
+  Serial.println(F("[CMD] Ephemeris demo mode - simulating sun arc"));
+  Serial.println(F("  Sunrise (East) -> Noon (Peak) -> Sunset (West)"));
+}
+
+// PID [<kp> <ki> <kd> <kff>] - gains in thousandths
+static void cmd_pid(const CommandArgs_t* args) {
+  if (args->count == 4) {
+    if (!action_pid(args->value)) {
+      Serial.print(F("[CMD] Error: Gains must be 0-"));
+      Serial.println(PID_GAIN_MAX_MILLI);
+      return;
+    }
+  } else if (args->count > 0) {
+    print_usage(args);
     return;
   }
   
-  // Skip leading whitespace
-  while (*cmd == ' ') cmd++;
+  const TrackingGains_t* gains = tracking_get_gains();
+  Serial.print(F("[CMD] PID x1000 - Kp: "));
+  Serial.print(((int32_t)gains->kp.raw() * 1000) / Gain_t::ONE);
+  Serial.print(F(" Ki: "));
+  Serial.print(((int32_t)gains->ki.raw() * 1000) / Gain_t::ONE);
+  Serial.print(F(" Kd: "));
+  Serial.print(((int32_t)gains->kd.raw() * 1000) / Gain_t::ONE);
+  Serial.print(F(" Kff: "));
+  Serial.println(((int32_t)gains->kff.raw() * 1000) / Gain_t::ONE);
+}
+
+// TIME [<unix_seconds>]
+static void cmd_time(const CommandArgs_t* args) {
+  if (args->count == 1) {
+    ephemeris_set_time((uint32_t)args->value[0]);
+  }
+  Serial.print(F("[CMD] UTC time: "));
+  Serial.println(ephemeris_get_time());
+}
+
+// SITE [<lat_cdeg> <lon_cdeg> <mount_az_deg>]
+static void cmd_site(const CommandArgs_t* args) {
+  if (args->count == 3) {
+    int32_t lat = args->value[0];
+    int32_t lon = args->value[1];
+    int32_t mount = args->value[2];
+    if (lat < -9000 || lat > 9000 || lon < -18000 || lon > 18000 ||
+        mount < 0 || mount >= 360) {
+      Serial.println(F("[CMD] Error: Lat +/-9000, Lon +/-18000 (0.01 deg), Mount 0-359"));
+      return;
+    }
+    Config_t* cfg = config_get_mutable();
+    cfg->site_latitude_cdeg = lat;
+    cfg->site_longitude_cdeg = lon;
+    cfg->mount_azimuth_deg = mount;
+    cfg->site_valid = 1;
+    config_mark_dirty();
+  } else if (args->count > 0) {
+    print_usage(args);
+    return;
+  }
   
-  // MANUAL <azimuth> <elevation>
-  if (strncmp(cmd, "MANUAL", 6) == 0) {
-    const char* args = cmd + 6;
-    
-    // Validate input length
-    if (strlen(args) > CMD_MAX_ARG_LENGTH) {
-      Serial.println(F("[CMD] Error: Arguments too long"));
+  const Config_t* cfg = config_get();
+  Serial.print(F("[CMD] Site - Lat: "));
+  Serial.print(cfg->site_latitude_cdeg);
+  Serial.print(F(" Lon: "));
+  Serial.print(cfg->site_longitude_cdeg);
+  Serial.print(F(" (0.01 deg) Mount: "));
+  Serial.print(cfg->mount_azimuth_deg);
+  Serial.println(cfg->site_valid ? F("°") : F("° [NOT SET]"));
+}
+
+// ENDPOINT [AZ|EL <min_us> <max_us>]
+static void cmd_endpoint(const CommandArgs_t* args) {
+  if (args->count > 0) {
+    uint8_t axis;
+    if (args->count != 3 || !parse_axis(args->text[0], &axis)) {
+      print_usage(args);
       return;
     }
+    if (args->value[1] < 0 || args->value[1] > UINT16_MAX ||
+        args->value[2] < 0 || args->value[2] > UINT16_MAX ||
+        !servo_set_endpoints(axis, args->value[1], args->value[2])) {
+      Serial.print(F("[CMD] Error: Pulse widths must be "));
+      Serial.print(SERVO_PULSE_LIMIT_MIN_US);
+      Serial.print(F("-"));
+      Serial.print(SERVO_PULSE_LIMIT_MAX_US);
+      Serial.println(F(" us and differ"));
+      return;
+    }
+  }
+  
+  const Config_t* cfg = config_get();
+  Serial.print(F("[CMD] Endpoints (us) - Az: "));
+  Serial.print(cfg->servo_min_us[SERVO_AXIS_AZIMUTH]);
+  Serial.print(F("-"));
+  Serial.print(cfg->servo_max_us[SERVO_AXIS_AZIMUTH]);
+  Serial.print(F(" El: "));
+  Serial.print(cfg->servo_min_us[SERVO_AXIS_ELEVATION]);
+  Serial.print(F("-"));
+  Serial.println(cfg->servo_max_us[SERVO_AXIS_ELEVATION]);
+}
+
+// SLEW [AZ|EL <deg_per_s> <deg_per_s2>]
+static void cmd_slew(const CommandArgs_t* args) {
+  if (args->count > 0) {
+    uint8_t axis;
+    if (args->count != 3 || !parse_axis(args->text[0], &axis) ||
+        args->value[1] < 0 || args->value[1] > SERVO_MAX_SPEED_DPS ||
+        args->value[2] < 0 || args->value[2] > SERVO_MAX_ACCEL_DPS2) {
+      Serial.print(F("[CMD] Usage: SLEW <AZ|EL> <deg/s 0-"));
+      Serial.print(SERVO_MAX_SPEED_DPS);
+      Serial.print(F("> <deg/s^2 0-"));
+      Serial.print(SERVO_MAX_ACCEL_DPS2);
+      Serial.println(F("> (0 = unlimited)"));
+      return;
+    }
+    servo_set_motion_limits(axis, args->value[1] * SERVO_CDEG_PER_DEG,
+                            args->value[2] * SERVO_CDEG_PER_DEG);
+  }
+  
+  const Config_t* cfg = config_get();
+  Serial.print(F("[CMD] Slew limits (deg/s, deg/s^2) - Az: "));
+  Serial.print(cfg->servo_max_speed[SERVO_AXIS_AZIMUTH] / SERVO_CDEG_PER_DEG);
+  Serial.print(F("/"));
+  Serial.print(cfg->servo_max_accel[SERVO_AXIS_AZIMUTH] / SERVO_CDEG_PER_DEG);
+  Serial.print(F(" El: "));
+  Serial.print(cfg->servo_max_speed[SERVO_AXIS_ELEVATION] / SERVO_CDEG_PER_DEG);
+  Serial.print(F("/"));
+  Serial.println(cfg->servo_max_accel[SERVO_AXIS_ELEVATION] / SERVO_CDEG_PER_DEG);
+}
+
+// TASKS [RESET]
+static void cmd_tasks(const CommandArgs_t* args) {
+  if (args->count == 1) {
+    if (strcmp_P(args->text[0], PSTR("RESET")) != 0) {
+      print_usage(args);
+      return;
+    }
+    scheduler_reset_stats();
+    control_timer_reset_stats();
+    Serial.println(F("[CMD] Task and control timing statistics cleared"));
+    return;
+  }
+  
+  Serial.println(F("[CMD] Task       prio period_ms budget_us max_us runs overruns skipped"));
+  for (uint8_t i = 0; i < scheduler_get_task_count(); i++) {
+    Task_t task;
+    memcpy_P(&task, scheduler_get_task(i), sizeof(task));
+    const TaskStats_t* stats = scheduler_get_stats(i);
+    Serial.print(F("  "));
+    Serial.print((const __FlashStringHelper*)task.name);
+    Serial.print(F(" "));
+    Serial.print(task.priority);
+    Serial.print(F(" "));
+    Serial.print(scheduler_get_period(i));
+    Serial.print(F(" "));
+    Serial.print(task.budget_us);
+    Serial.print(F(" "));
+    Serial.print(stats->max_exec_us);
+    Serial.print(F(" "));
+    Serial.print(stats->run_count);
+    Serial.print(F(" "));
+    Serial.print(stats->overruns);
+    Serial.print(F(" "));
+    Serial.println(stats->skipped);
+  }
+}
+
+// PROF [RESET|STREAM ON|STREAM OFF]
+static void cmd_prof(const CommandArgs_t* args) {
+  if (args->count == 0) {
+    profiler_print();
+  } else if (args->count == 1 && strcmp_P(args->text[0], PSTR("RESET")) == 0) {
+    profiler_reset();
+    Serial.println(F("[CMD] Profile cleared"));
+  } else if (args->count == 2 && strcmp_P(args->text[0], PSTR("STREAM")) == 0 &&
+             strcmp_P(args->text[1], PSTR("ON")) == 0) {
+    profiler_set_streaming(true);
+    Serial.println(F("[CMD] Profile streaming with telemetry"));
+  } else if (args->count == 2 && strcmp_P(args->text[0], PSTR("STREAM")) == 0 &&
+             strcmp_P(args->text[1], PSTR("OFF")) == 0) {
+    profiler_set_streaming(false);
+    Serial.println(F("[CMD] Profile streaming stopped"));
+  } else {
+    print_usage(args);
+  }
+}
+
+// TELEM [BIN|JSON|RATE <ms>|FIELDS <ALL|NONE|group...>]
+static void cmd_telem(const CommandArgs_t* args) {
+  if (args->count > 0) {
+    const char* option = args->text[0];
+    char* rest = (args->count > 1) ? args->text[1] : NULL;
     
-    int az, el;
-    if (sscanf(args, "%d %d", &az, &el) == 2) {
-      // Validate ranges
-      if (az >= MIN_AZIMUTH_DEG && az <= MAX_AZIMUTH_DEG &&
-          el >= MIN_ELEVATION_DEG && el <= MAX_ELEVATION_DEG) {
-        
-        g_control_mode = CONTROL_MANUAL;
-        g_pending_command.azimuth = (uint16_t)az;
-        g_pending_command.elevation = (uint16_t)el;
-        g_pending_command.crc16 = crc16(&g_pending_command, 
-                                        offsetof(ServoCommand_t, crc16));
-        g_has_pending = true;
-        
-        Serial.print(F("[CMD] Manual mode - Az: "));
-        Serial.print(az);
-        Serial.print(F("° El: "));
-        Serial.print(el);
-        Serial.println(F("°"));
-      } else {
-        Serial.println(F("[CMD] Error: Position out of range"));
-        Serial.print(F("  Valid: Az["));
-        Serial.print(MIN_AZIMUTH_DEG);
+    if (rest == NULL && strcmp_P(option, PSTR("BIN")) == 0) {
+      telemetry_set_format(TELEMETRY_FORMAT_BINARY);
+    } else if (rest == NULL && strcmp_P(option, PSTR("JSON")) == 0) {
+      telemetry_set_format(TELEMETRY_FORMAT_JSON);
+    } else if (strcmp_P(option, PSTR("RATE")) == 0) {
+      uint32_t period_ms;
+      if (rest == NULL || !token_to_uint(rest, &period_ms) ||
+          period_ms > UINT16_MAX || !telemetry_set_period(period_ms)) {
+        Serial.print(F("[CMD] Usage: TELEM RATE <"));
+        Serial.print(TELEMETRY_MIN_PERIOD_MS);
         Serial.print(F("-"));
-        Serial.print(MAX_AZIMUTH_DEG);
-        Serial.print(F("] El["));
-        Serial.print(MIN_ELEVATION_DEG);
-        Serial.print(F("-"));
-        Serial.print(MAX_ELEVATION_DEG);
-        Serial.println(F("]"));
+        Serial.print(TELEMETRY_MAX_PERIOD_MS);
+        Serial.println(F(" ms>"));
+        return;
+      }
+    } else if (strcmp_P(option, PSTR("FIELDS")) == 0) {
+      uint8_t groups;
+      if (rest == NULL || !parse_telemetry_fields(rest, &groups)) {
+        Serial.println(F("[CMD] Usage: TELEM FIELDS <ALL|NONE|SENSORS SUN SERVOS POWER TIMING ERRORS HEALTH>"));
+        return;
       }
+      telemetry_set_groups(groups);
     } else {
-      Serial.println(F("[CMD] Usage: MANUAL <azimuth> <elevation>"));
+      print_usage(args);
+      return;
     }
   }
   
-  // AUTO
-  else if (strncmp(cmd, "AUTO", 4) == 0) {
-    g_control_mode = CONTROL_AUTO;
-    g_has_pending = false;
-    Serial.println(F("[CMD] Automatic tracking mode"));
-  }
-  
-  // HOME
-  else if (strncmp(cmd, "HOME", 4) == 0) {
-    g_control_mode = CONTROL_MANUAL;
-    g_pending_command.azimuth = DEFAULT_AZIMUTH_DEG;
-    g_pending_command.elevation = DEFAULT_ELEVATION_DEG;
-    g_pending_command.crc16 = crc16(&g_pending_command, 
-                                    offsetof(ServoCommand_t, crc16));
-    g_has_pending = true;
-    Serial.println(F("[CMD] Moving to home position"));
-  }
-  
-  // HELP
-  else if (strncmp(cmd, "HELP", 4) == 0 || *cmd == '?') {
-    Serial.println(F("\n=== Command Reference ==="));
-    Serial.println(F("MANUAL <az> <el> - Move to position (e.g. MANUAL 90 60)"));
-    Serial.println(F("AUTO             - Return to sun tracking mode"));
-    Serial.println(F("HOME             - Move to default position"));
-    Serial.println(F("HELP or ?        - Show this help"));
-    Serial.print(F("\nValid ranges: Az["));
-    Serial.print(MIN_AZIMUTH_DEG);
-    Serial.print(F("-"));
-    Serial.print(MAX_AZIMUTH_DEG);
-    Serial.print(F("] El["));
-    Serial.print(MIN_ELEVATION_DEG);
-    Serial.print(F("-"));
-    Serial.print(MAX_ELEVATION_DEG);
-    Serial.println(F("]"));
-  }
-
-  else if (strncmp(cmd, "DEMO", 4) == 0) {
-    g_control_mode = CONTROL_DEMO;
-    g_demo_start_time = millis();
-    g_has_pending = false;
-    Serial.println(F("[CMD] Ephemeris demo mode - simulating sun arc"));
-    Serial.println(F("  Sunrise (East) -> Noon (Peak) -> Sunset (West)"));
+  Serial.print(F("[CMD] Telemetry format: "));
+  Serial.print(telemetry_get_format() == TELEMETRY_FORMAT_BINARY ? F("BIN") : F("JSON"));
+  Serial.print(F(" period: "));
+  Serial.print(telemetry_get_period());
+  Serial.print(F(" ms fields:"));
+  uint8_t groups = telemetry_get_groups();
+  for (uint8_t field = 0; field < TELEM_FIELD_COUNT; field++) {
+    if (groups & (1 << field)) {
+      Serial.print(' ');
+      Serial.print((const __FlashStringHelper*)pgm_read_ptr(&k_field_names[field]));
+    }
   }
+  Serial.println();
+}
+
+// REC [DUMP|FREEZE|ARM]
+static void cmd_rec(const CommandArgs_t* args) {
+  if (args->count == 0) {
+    flight_recorder_print_status();
+  } else if (strcmp_P(args->text[0], PSTR("DUMP")) == 0) {
+    flight_recorder_start_dump();
+  } else if (strcmp_P(args->text[0], PSTR("FREEZE")) == 0) {
+    flight_recorder_trigger(FR_TRIGGER_MANUAL, 0);
+    flight_recorder_print_status();
+  } else if (strcmp_P(args->text[0], PSTR("ARM")) == 0) {
+    if (flight_recorder_rearm()) {
+      Serial.println(F("[CMD] Flight recorder re-armed"));
+    } else {
+      Serial.println(F("[CMD] Error: Recorder memory in use by CAL (CAL SAVE or CAL ABORT)"));
+    }
+  } else {
+    print_usage(args);
+  }
+}
+
+// JOURNAL [DUMP]
+static void cmd_journal(const CommandArgs_t* args) {
+  if (args->count == 0) {
+    journal_print_status();
+  } else if (strcmp_P(args->text[0], PSTR("DUMP")) == 0) {
+    journal_start_dump();
+  } else {
+    print_usage(args);
+  }
+}
+
+// WP [ADD <t_ms> <az_cdeg> <el_cdeg>|GO|END|CLEAR]
+static void cmd_wp(const CommandArgs_t* args) {
+  const char* op = (args->count > 0) ? args->text[0] : NULL;
   
-  // Unknown command
-  else if (*cmd != '\0') {
+  if (op == NULL) {
+    // Status only
+  } else if (args->count == 4 && strcmp_P(op, PSTR("ADD")) == 0) {
+    Waypoint_t point;
+    point.time_ms = args->value[1];
+    point.azimuth_cdeg = (uint16_t)min((uint32_t)args->value[2], 0xFFFFUL);
+    point.elevation_cdeg = (uint16_t)min((uint32_t)args->value[3], 0xFFFFUL);
+    switch (trajectory_add(&point)) {
+      case TRAJ_ADD_OK:
+        break;
+      case TRAJ_ADD_FULL:
+        Serial.println(F("[CMD] Error: Waypoint queue full"));
+        return;
+      case TRAJ_ADD_RANGE:
+        Serial.print(F("[CMD] Error: Waypoint out of range, valid (x100): "));
+        print_position_ranges();
+        return;
+      case TRAJ_ADD_ORDER:
+        Serial.println(F("[CMD] Error: Waypoint times must increase"));
+        return;
+      case TRAJ_ADD_CLOSED:
+        Serial.println(F("[CMD] Error: Trajectory ended, WP CLEAR to start another"));
+        return;
+    }
+  } else if (args->count == 1 && strcmp_P(op, PSTR("GO")) == 0) {
+    if (!action_trajectory_start()) {
+      Serial.println(F("[CMD] Error: Trajectory already started, WP CLEAR first"));
+      return;
+    }
+  } else if (args->count == 1 && strcmp_P(op, PSTR("END")) == 0) {
+    trajectory_end();
+  } else if (args->count == 1 && strcmp_P(op, PSTR("CLEAR")) == 0) {
+    trajectory_clear();
+  } else {
+    print_usage(args);
+    return;
+  }
+  
+  trajectory_print_status();
+}
+
+// CAL START|SAVE|ABORT|CLEAR
+static void cmd_cal(const CommandArgs_t* args) {
+  const char* op = args->text[0];
+  
+  if (strcmp_P(op, PSTR("START")) == 0) {
+    sensor_cal_start();
+    Serial.println(F("[CMD] Calibration capture started - sweep light dark to bright"));
+  } else if (strcmp_P(op, PSTR("SAVE")) == 0) {
+    if (!sensor_cal_is_capturing()) {
+      Serial.println(F("[CMD] Error: No capture running (CAL START)"));
+    } else if (sensor_cal_finish()) {
+      Serial.println(F("[CMD] Calibration applied, saving to EEPROM"));
+    } else {
+      Serial.println(F("[CMD] Error: Sweep too narrow, still capturing (keep sweeping or CAL ABORT)"));
+    }
+  } else if (strcmp_P(op, PSTR("ABORT")) == 0) {
+    sensor_cal_abort();
+    Serial.println(F("[CMD] Calibration capture aborted"));
+  } else if (strcmp_P(op, PSTR("CLEAR")) == 0) {
+    sensor_cal_reset();
+    Serial.println(F("[CMD] Calibration reset to identity"));
+  } else {
+    print_usage(args);
+  }
+}
+
+static void cmd_help(const CommandArgs_t* args);
+
+// Argument schemas
+static const char k_args_none[] PROGMEM = "";
+static const char k_args_ii[] PROGMEM = "ii";
+static const char k_args_w[] PROGMEM = "w";
+static const char k_args_opt_w[] PROGMEM = "[w";
+static const char k_args_opt_ww[] PROGMEM = "[ww";
+static const char k_args_opt_wrest[] PROGMEM = "[w*";
+static const char k_args_opt_u[] PROGMEM = "[u";
+static const char k_args_opt_iii[] PROGMEM = "[iii";
+static const char k_args_opt_iiii[] PROGMEM = "[iiii";
+static const char k_args_opt_wii[] PROGMEM = "[wii";
+static const char k_args_opt_wuuu[] PROGMEM = "[wuuu";
+
+static const char k_syn_manual[] PROGMEM = "MANUAL <az> <el>";
+static const char k_help_manual[] PROGMEM = "Move to position (e.g. MANUAL 90 60)";
+static const char k_syn_auto[] PROGMEM = "AUTO";
+static const char k_help_auto[] PROGMEM = "Return to sun tracking mode";
+static const char k_syn_home[] PROGMEM = "HOME";
+static const char k_help_home[] PROGMEM = "Move to default position";
+static const char k_syn_demo[] PROGMEM = "DEMO";
+static const char k_help_demo[] PROGMEM = "Simulated sun arc (45 s)";
+static const char k_syn_pid[] PROGMEM = "PID [kp ki kd kff]";
+static const char k_help_pid[] PROGMEM = "Show/set tracking gains x1000";
+static const char k_syn_cal[] PROGMEM = "CAL <op>";
+static const char k_help_cal[] PROGMEM = "Sensor calibration: START|SAVE|ABORT|CLEAR";
+static const char k_syn_time[] PROGMEM = "TIME [unix]";
+static const char k_help_time[] PROGMEM = "Show/set UTC time for ephemeris";
+static const char k_syn_endpoint[] PROGMEM = "ENDPOINT [AZ|EL min max]";
+static const char k_help_endpoint[] PROGMEM = "Show/set servo pulse endpoints (us)";
+static const char k_syn_slew[] PROGMEM = "SLEW [AZ|EL vel acc]";
+static const char k_help_slew[] PROGMEM = "Show/set servo speed/accel limits (deg/s, deg/s^2)";
+static const char k_syn_tasks[] PROGMEM = "TASKS [RESET]";
+static const char k_help_tasks[] PROGMEM = "Show/clear scheduler and control timing statistics";
+static const char k_syn_prof[] PROGMEM = "PROF [RESET|STREAM ON|OFF]";
+static const char k_help_prof[] PROGMEM = "Per-stage profile (uno_profile build)";
+static const char k_syn_telem[] PROGMEM = "TELEM [BIN|JSON|RATE ms|FIELDS group...]";
+static const char k_help_telem[] PROGMEM = "Show/set telemetry format (see protocol.h), period, field groups";
+static const char k_syn_site[] PROGMEM = "SITE [lat lon mount]";
+static const char k_help_site[] PROGMEM = "Show/set site (0.01 deg) and mount bearing";
+static const char k_syn_rec[] PROGMEM = "REC [DUMP|FREEZE|ARM]";
+static const char k_help_rec[] PROGMEM = "Flight recorder status/dump/freeze/re-arm";
+static const char k_syn_journal[] PROGMEM = "JOURNAL [DUMP]";
+static const char k_help_journal[] PROGMEM = "EEPROM fault journal status/export (survives resets)";
+static const char k_syn_wp[] PROGMEM = "WP [ADD t_ms az el|GO|END|CLEAR]";
+static const char k_help_wp[] PROGMEM = "Waypoint queue (0.01 deg), run it, close it, drop it";
+static const char k_syn_help[] PROGMEM = "HELP";
+static const char k_help_help[] PROGMEM = "Show this help (also ?)";
+static const char k_syn_help_alias[] PROGMEM = "?";
+
+static const Command_t k_commands[] PROGMEM = {
+  // synopsis          args              help               run
+  { k_syn_manual,      k_args_ii,        k_help_manual,     cmd_manual },
+  { k_syn_auto,        k_args_none,      k_help_auto,       cmd_auto },
+  { k_syn_home,        k_args_none,      k_help_home,       cmd_home },
+  { k_syn_demo,        k_args_none,      k_help_demo,       cmd_demo },
+  { k_syn_pid,         k_args_opt_iiii,  k_help_pid,        cmd_pid },
+  { k_syn_cal,         k_args_w,         k_help_cal,        cmd_cal },
+  { k_syn_time,        k_args_opt_u,     k_help_time,       cmd_time },
+  { k_syn_endpoint,    k_args_opt_wii,   k_help_endpoint,   cmd_endpoint },
+  { k_syn_slew,        k_args_opt_wii,   k_help_slew,       cmd_slew },
+  { k_syn_tasks,       k_args_opt_w,     k_help_tasks,      cmd_tasks },
+  { k_syn_prof,        k_args_opt_ww,    k_help_prof,       cmd_prof },
+  { k_syn_telem,       k_args_opt_wrest, k_help_telem,      cmd_telem },
+  { k_syn_site,        k_args_opt_iii,   k_help_site,       cmd_site },
+  { k_syn_rec,         k_args_opt_w,     k_help_rec,        cmd_rec },
+  { k_syn_journal,     k_args_opt_w,     k_help_journal,    cmd_journal },
+  { k_syn_wp,          k_args_opt_wuuu,  k_help_wp,         cmd_wp },
+  { k_syn_help,        k_args_none,      k_help_help,       cmd_help },
+  { k_syn_help_alias,  k_args_none,      NULL,              cmd_help },   // Not listed
+};
+
+#define COMMAND_COUNT  (sizeof(k_commands) / sizeof(k_commands[0]))
+
+// HELP - generated from the table
+static void cmd_help(const CommandArgs_t* args) {
+  (void)args;
+  Serial.println(F("\n=== Command Reference ==="));
+  for (uint8_t i = 0; i < COMMAND_COUNT; i++) {
+    PGM_P help = (PGM_P)pgm_read_ptr(&k_commands[i].help);
+    if (help == NULL) {
+      continue;
+    }
+    PGM_P synopsis = (PGM_P)pgm_read_ptr(&k_commands[i].synopsis);
+    Serial.print((const __FlashStringHelper*)synopsis);
+    for (size_t column = strlen_P(synopsis); column < HELP_SYNOPSIS_WIDTH; column++) {
+      Serial.print(' ');
+    }
+    Serial.print(F(" - "));
+    Serial.println((const __FlashStringHelper*)help);
+  }
+  Serial.print(F("\nValid ranges: "));
+  print_position_ranges();
+}
+
+/**
+ * @brief Find a command by name
+ *
+ * Compares against the leading word of each synopsis.
+ * @return PROGMEM entry, or NULL
+ */
+static const Command_t* command_find(const char* name) {
+  size_t length = strlen(name);
+  for (uint8_t i = 0; i < COMMAND_COUNT; i++) {
+    PGM_P synopsis = (PGM_P)pgm_read_ptr(&k_commands[i].synopsis);
+    char next = pgm_read_byte(synopsis + length);
+    if ((next == ' ' || next == '\0') && strncmp_P(name, synopsis, length) == 0) {
+      return &k_commands[i];
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief Tokenize the arguments and check them against a schema
+ * @param schema PROGMEM argument schema
+ * @param cursor Text after the command name (tokenized in place)
+ * @param args Output
+ * @return false on a missing, extra or malformed argument
+ */
+static bool parse_arguments(PGM_P schema, char* cursor, CommandArgs_t* args) {
+  bool optional = false;
+  args->count = 0;
+  
+  for (;;) {
+    char kind = pgm_read_byte(schema++);
+    if (kind == '[') {
+      optional = true;
+      continue;
+    }
+    if (kind == '\0') {
+      return token_next(&cursor) == NULL;
+    }
+    
+    char* token = (kind == '*') ? token_rest(&cursor) : token_next(&cursor);
+    if (token == NULL) {
+      return optional;
+    }
+    if (args->count >= CMD_MAX_ARGS) {
+      return false;
+    }
+    
+    int32_t value = 0;
+    if (kind == 'i' && !token_to_int(token, &value)) {
+      return false;
+    }
+    if (kind == 'u' && !token_to_uint(token, (uint32_t*)&value)) {
+      return false;
+    }
+    args->text[args->count] = token;
+    args->value[args->count] = value;
+    args->count++;
+  }
+}
+
+/**
+ * @brief Parse and execute a command line
+ * @param line Command text, tokenized in place
+ */
+static void command_parse(char* line) {
+  char* cursor = line;
+  char* name = token_next(&cursor);
+  if (name == NULL) {
+    return;
+  }
+  
+  CommandArgs_t args;
+  args.command = command_find(name);
+  if (args.command == NULL) {
     Serial.print(F("[CMD] Unknown command: "));
-    Serial.println(cmd);
+    Serial.println(name);
     Serial.println(F("Type HELP for command list"));
+    return;
   }
+  
+  if (!parse_arguments((PGM_P)pgm_read_ptr(&args.command->args), cursor, &args)) {
+    print_usage(&args);
+    return;
+  }
+  
+  CommandRun_t run = (CommandRun_t)pgm_read_ptr(&args.command->run);
+  run(&args);
+}
+
+// ============================================================================
+// BINARY COMMANDS (protocol.h)
+// ============================================================================
+
+typedef uint8_t (*BinaryRun_t)(const uint8_t* payload);
+
+/**
+ * @brief Binary opcode table entry (PROGMEM, indexed by opcode - 1)
+ */
+typedef struct {
+  uint8_t length;                // Required payload length
+  BinaryRun_t run;               // Returns CMD_STATUS_*
+} BinaryCommand_t;
+
+/**
+ * @brief Servo commands are not executed in EMERGENCY; say so instead of
+ *        acknowledging a move that will not happen
+ */
+static bool servos_locked_out() {
+  return safety_get_mode() == MODE_EMERGENCY;
+}
+
+static uint8_t bin_ping(const uint8_t* payload) {
+  (void)payload;
+  return CMD_STATUS_OK;
+}
+
+static uint8_t bin_auto(const uint8_t* payload) {
+  (void)payload;
+  action_auto();
+  return CMD_STATUS_OK;
+}
+
+static uint8_t bin_home(const uint8_t* payload) {
+  (void)payload;
+  if (servos_locked_out()) {
+    return CMD_STATUS_REJECTED;
+  }
+  action_home();
+  return CMD_STATUS_OK;
+}
+
+static uint8_t bin_demo(const uint8_t* payload) {
+  (void)payload;
+  if (servos_locked_out()) {
+    return CMD_STATUS_REJECTED;
+  }
+  action_demo();
+  return CMD_STATUS_OK;
+}
+
+static uint8_t bin_manual(const uint8_t* payload) {
+  CmdManual_t manual;
+  memcpy(&manual, payload, sizeof(manual));
+  if (servos_locked_out()) {
+    return CMD_STATUS_REJECTED;
+  }
+  return action_manual(manual.azimuth_cdeg, manual.elevation_cdeg) ?
+         CMD_STATUS_OK : CMD_STATUS_OUT_OF_RANGE;
+}
+
+static uint8_t bin_pid(const uint8_t* payload) {
+  CmdPid_t pid;
+  memcpy(&pid, payload, sizeof(pid));
+  int32_t gain_milli[4];
+  for (uint8_t i = 0; i < 4; i++) {
+    gain_milli[i] = pid.gain_milli[i];
+  }
+  return action_pid(gain_milli) ? CMD_STATUS_OK : CMD_STATUS_OUT_OF_RANGE;
+}
+
+static uint8_t bin_time(const uint8_t* payload) {
+  uint32_t unix_seconds;
+  memcpy(&unix_seconds, payload, sizeof(unix_seconds));
+  ephemeris_set_time(unix_seconds);
+  return CMD_STATUS_OK;
+}
+
+static uint8_t bin_telem_rate(const uint8_t* payload) {
+  uint16_t period_ms;
+  memcpy(&period_ms, payload, sizeof(period_ms));
+  return telemetry_set_period(period_ms) ? CMD_STATUS_OK : CMD_STATUS_OUT_OF_RANGE;
+}
+
+static uint8_t bin_telem_fields(const uint8_t* payload) {
+  if (payload[0] & ~TELEM_GROUP_ALL) {
+    return CMD_STATUS_OUT_OF_RANGE;
+  }
+  telemetry_set_groups(payload[0]);
+  return CMD_STATUS_OK;
+}
+
+static uint8_t bin_telem_format(const uint8_t* payload) {
+  if (payload[0] > TELEMETRY_FORMAT_BINARY) {
+    return CMD_STATUS_OUT_OF_RANGE;
+  }
+  telemetry_set_format((TelemetryFormat_t)payload[0]);
+  return CMD_STATUS_OK;
+}
+
+static uint8_t bin_wp_add(const uint8_t* payload) {
+  CmdWaypoint_t waypoint;
+  memcpy(&waypoint, payload, sizeof(waypoint));
+  Waypoint_t point;
+  point.time_ms = waypoint.time_ms;
+  point.azimuth_cdeg = waypoint.azimuth_cdeg;
+  point.elevation_cdeg = waypoint.elevation_cdeg;
+  
+  switch (trajectory_add(&point)) {
+    case TRAJ_ADD_OK:
+      return CMD_STATUS_OK;
+    case TRAJ_ADD_FULL:
+      return CMD_STATUS_QUEUE_FULL;
+    case TRAJ_ADD_RANGE:
+      return CMD_STATUS_OUT_OF_RANGE;
+    default:
+      return CMD_STATUS_REJECTED;   // Out of order, or after WP_END
+  }
+}
+
+static uint8_t bin_wp_start(const uint8_t* payload) {
+  (void)payload;
+  if (servos_locked_out() || !action_trajectory_start()) {
+    return CMD_STATUS_REJECTED;
+  }
+  return CMD_STATUS_OK;
+}
+
+static uint8_t bin_wp_end(const uint8_t* payload) {
+  (void)payload;
+  trajectory_end();
+  return CMD_STATUS_OK;
+}
+
+static uint8_t bin_wp_clear(const uint8_t* payload) {
+  (void)payload;
+  trajectory_clear();
+  return CMD_STATUS_OK;
+}
+
+static const BinaryCommand_t k_binary_commands[] PROGMEM = {
+  { 0,                    bin_ping },           // CMD_OP_PING
+  { 0,                    bin_auto },           // CMD_OP_AUTO
+  { 0,                    bin_home },           // CMD_OP_HOME
+  { 0,                    bin_demo },           // CMD_OP_DEMO
+  { sizeof(CmdManual_t),  bin_manual },         // CMD_OP_MANUAL
+  { sizeof(CmdPid_t),     bin_pid },            // CMD_OP_PID
+  { sizeof(uint32_t),     bin_time },           // CMD_OP_TIME
+  { sizeof(uint16_t),     bin_telem_rate },     // CMD_OP_TELEM_RATE
+  { sizeof(uint8_t),      bin_telem_fields },   // CMD_OP_TELEM_FIELDS
+  { sizeof(uint8_t),      bin_telem_format },   // CMD_OP_TELEM_FORMAT
+  { sizeof(CmdWaypoint_t), bin_wp_add },        // CMD_OP_WP_ADD
+  { 0,                    bin_wp_start },       // CMD_OP_WP_START
+  { 0,                    bin_wp_end },         // CMD_OP_WP_END
+  { 0,                    bin_wp_clear },       // CMD_OP_WP_CLEAR
+};
+
+#define BINARY_COMMAND_COUNT  (sizeof(k_binary_commands) / sizeof(k_binary_commands[0]))
+
+static_assert(BINARY_COMMAND_COUNT == CMD_OP_WP_CLEAR, "binary command table out of step with protocol.h");
+
+/**
+ * @brief Run one command record
+ * @return CMD_STATUS_*
+ */
+static uint8_t run_binary(uint8_t opcode, const uint8_t* payload, uint8_t length) {
+  if (opcode == 0 || opcode > BINARY_COMMAND_COUNT) {
+    return CMD_STATUS_UNKNOWN_OP;
+  }
+  const BinaryCommand_t* entry = &k_binary_commands[opcode - 1];
+  if (length != pgm_read_byte(&entry->length)) {
+    return CMD_STATUS_BAD_LENGTH;
+  }
+  BinaryRun_t run = (BinaryRun_t)pgm_read_ptr(&entry->run);
+  return run(payload);
+}
+
+/**
+ * @brief Check that the records exactly fill the payload
+ */
+static bool records_fit(const uint8_t* payload, uint8_t length, uint8_t count) {
+  uint16_t offset = sizeof(CmdHeader_t);
+  for (uint8_t i = 0; i < count; i++) {
+    if (offset + sizeof(CmdRecord_t) > length) {
+      return false;
+    }
+    offset += sizeof(CmdRecord_t) + payload[offset + offsetof(CmdRecord_t, length)];
+  }
+  return offset == length;
+}
+
+/**
+ * @brief Frame and send a reply
+ * @param ack Header space followed by count status bytes, plus room for the CRC
+ */
+static void send_ack(uint8_t* ack, uint16_t request_id, uint8_t status, uint8_t count) {
+  CmdAckHeader_t header;
+  header.type = CMD_ACK_TYPE;
+  header.version = CMD_PROTOCOL_VERSION;
+  header.request_id = request_id;
+  header.status = status;
+  header.count = count;
+  memcpy(ack, &header, sizeof(header));
+  
+  uint8_t length = sizeof(header) + count;
+  uint16_t crc = crc16(ack, length);
+  memcpy(ack + length, &crc, sizeof(crc));
+  length += sizeof(crc);
+  
+  uint8_t encoded[COBS_MAX_ENCODED(CMD_MAX_ACK_PAYLOAD)];
+  size_t encoded_length = cobs_encode(ack, length, encoded);
+  Serial.write((uint8_t)CMD_FRAME_DELIMITER);
+  Serial.write(encoded, encoded_length);
+  Serial.write((uint8_t)CMD_FRAME_DELIMITER);
+}
+
+/**
+ * @brief Decode, check and run a binary request, then reply
+ *
+ * Nothing runs unless the whole request checks out.
+ * @param frame COBS bytes between the delimiters (decoded in place)
+ * @param encoded_length Byte count
+ */
+static void command_run_frame(uint8_t* frame, uint8_t encoded_length) {
+  uint8_t ack[CMD_MAX_ACK_PAYLOAD];
+  uint8_t* results = ack + sizeof(CmdAckHeader_t);
+  
+  // Decoding never writes ahead of the byte it reads, so in place is safe
+  uint8_t length = cobs_decode(frame, encoded_length, frame);
+  
+  CmdHeader_t header;
+  uint16_t crc;
+  if (length < sizeof(header) + sizeof(crc)) {
+    send_ack(ack, 0, CMD_STATUS_BAD_FRAME, 0);
+    return;
+  }
+  memcpy(&header, frame, sizeof(header));
+  length -= sizeof(crc);
+  memcpy(&crc, frame + length, sizeof(crc));
+  
+  uint8_t status = CMD_STATUS_OK;
+  if (crc16(frame, length) != crc) {
+    status = CMD_STATUS_BAD_CRC;
+  } else if (header.type != CMD_FRAME_TYPE || header.version != CMD_PROTOCOL_VERSION) {
+    status = CMD_STATUS_BAD_VERSION;
+  } else if (header.count == 0 || header.count > CMD_MAX_BATCH ||
+             !records_fit(frame, length, header.count)) {
+    status = CMD_STATUS_BAD_FRAME;
+  }
+  if (status != CMD_STATUS_OK) {
+    send_ack(ack, header.request_id, status, 0);
+    return;
+  }
+  
+  // In order; the first failure stops the batch
+  uint8_t offset = sizeof(header);
+  bool failed = false;
+  for (uint8_t i = 0; i < header.count; i++) {
+    CmdRecord_t record;
+    memcpy(&record, frame + offset, sizeof(record));
+    offset += sizeof(record);
+    
+    results[i] = failed ? CMD_STATUS_SKIPPED :
+                 run_binary(record.opcode, frame + offset, record.length);
+    failed = (results[i] != CMD_STATUS_OK);
+    offset += record.length;
+  }
+  
+  send_ack(ack, header.request_id, CMD_STATUS_OK, header.count);
 }
 
 void command_handler_init(void) {
-  g_cmd_index = 0;
   g_control_mode = CONTROL_AUTO;
   g_has_pending = false;
   memset(g_cmd_buffer, 0, CMD_BUFFER_SIZE);
+  rx_splitter_init(&g_rx, g_cmd_buffer, CMD_BUFFER_SIZE,
+                   CMD_MAX_ENCODED, CMD_FRAME_TIMEOUT_MS);
   
   Serial.println(F("[CMD] Command interface ready (type HELP)"));
 }
 
-uint32_t command_get_demo_start_time(void) {
-  return g_demo_start_time;
-}
-
 void command_handler_process(void) {
   // Non-blocking serial read
   while (Serial.available() > 0) {
-    char c = Serial.read();
-    
-    // Handle newline (command complete)
-    if (c == '\n' || c == '\r') {
-      if (g_cmd_index > 0) {
-        g_cmd_buffer[g_cmd_index] = '\0';
+    switch (rx_splitter_feed(&g_rx, (char)Serial.read(), millis())) {
+      case RX_LINE:
         command_parse(g_cmd_buffer);
-        g_cmd_index = 0;
+        break;
+      case RX_FRAME:
+        command_run_frame((uint8_t*)g_cmd_buffer, g_rx.length);
+        break;
+      case RX_BAD_FRAME: {
+        uint8_t ack[CMD_MAX_ACK_PAYLOAD];
+        send_ack(ack, 0, CMD_STATUS_BAD_FRAME, 0);
+        break;
       }
-    }
-    // Add to buffer
-    else if (g_cmd_index < CMD_BUFFER_SIZE - 1) {
-      g_cmd_buffer[g_cmd_index++] = c;
-    }
-    // Buffer overflow protection
-    else {
-      Serial.println(F("[CMD] Error: Command too long"));
-      g_cmd_index = 0;
+      case RX_LINE_TOO_LONG:
+        Serial.println(F("[CMD] Error: Command too long"));
+        break;
+      default:
+        break;
     }
   }
 }
@@ -1,18 +1,41 @@
 /**
  * @file config_manager.cpp
  * @brief Configuration management implementation
+ *
+ * Background saves write one copy completely before touching the other,
+ * so a reset mid-save always leaves one valid copy for safe boot. A
+ * change during a save restarts the copy being written, then writes the
+ * other one.
  */
 
 #include "modules/config_manager.h"
 #include "config.h"
+#include "protocol.h"
 #include "utils/crc.h"
 #include "utils/ecc.h"
 #include <EEPROM.h>
+#include <avr/eeprom.h>
 #include <string.h>
 
+// Both ECC-encoded copies must fit between the two base addresses
+static_assert(2 * sizeof(Config_t) <= CONFIG_BACKUP_ADDR - CONFIG_PRIMARY_ADDR,
+              "Config_t too large for EEPROM layout");
+
+// Version 1 images end at boot_count, followed by their CRC; every field
+// up to there kept its offset in the current layout
+#define CONFIG_V1_CRC_OFFSET  offsetof(Config_t, sensor_cal)
+
 // Module state
 static Config_t g_config;
 static uint16_t g_local_error_counts[ERR_COUNT];
+static bool g_migrated = false;
+
+// Background save progress
+#define CONFIG_ENCODED_SIZE  (2 * sizeof(Config_t))
+static uint8_t g_save_copies = 0;      // Copies still to write, 0 when idle
+static uint16_t g_save_addr = 0;       // Copy being written
+static uint16_t g_save_index = 0;      // Next encoded byte within it
+static bool g_save_restart = false;
 
 /**
  * @brief Save configuration to EEPROM with ECC
@@ -29,6 +52,54 @@ static void config_save(const Config_t* cfg, uint16_t addr) {
   }
 }
 
+/**
+ * @brief One Hamming-encoded EEPROM byte of a configuration image
+ * @param index Encoded offset: low nibble of byte index/2 when even
+ */
+static uint8_t config_encoded_byte(const Config_t* cfg, uint16_t index) {
+  uint8_t byte = ((const uint8_t*)cfg)[index / 2];
+  return hamming_encode((index & 1) ? (byte >> 4) : (byte & 0x0F));
+}
+
+/**
+ * @brief Fold in the live error counts and refresh the CRC before a save
+ */
+static void config_seal() {
+  memcpy(g_config.error_counts, g_local_error_counts, sizeof(g_config.error_counts));
+  g_config.crc16 = crc16(&g_config, offsetof(Config_t, crc16));
+}
+
+/**
+ * @brief Upgrade a decoded version 1 image in place
+ *
+ * Keeps the servo offsets, error counts and boot count; every field added
+ * since takes its default.
+ *
+ * @return false if the image is not a valid version 1 configuration
+ */
+static bool config_migrate_v1(Config_t* cfg) {
+  uint16_t stored_crc;
+  memcpy(&stored_crc, (const uint8_t*)cfg + CONFIG_V1_CRC_OFFSET, sizeof(stored_crc));
+  if (cfg->magic != CONFIG_MAGIC || cfg->version != 1 ||
+      crc16(cfg, CONFIG_V1_CRC_OFFSET) != stored_crc) {
+    return false;
+  }
+  
+  uint16_t azimuth_offset = cfg->servo_azimuth_offset;
+  uint16_t elevation_offset = cfg->servo_elevation_offset;
+  uint16_t error_counts[ERR_COUNT];
+  memcpy(error_counts, cfg->error_counts, sizeof(error_counts));
+  uint32_t boot_count = cfg->boot_count;
+  
+  config_load_defaults(cfg);
+  cfg->servo_azimuth_offset = azimuth_offset;
+  cfg->servo_elevation_offset = elevation_offset;
+  memcpy(cfg->error_counts, error_counts, sizeof(error_counts));
+  cfg->boot_count = boot_count;
+  cfg->crc16 = crc16(cfg, offsetof(Config_t, crc16));
+  return true;
+}
+
 /**
  * @brief Load configuration from EEPROM with ECC correction
  */
@@ -56,7 +127,14 @@ static bool config_load(Config_t* cfg, uint16_t addr) {
     Serial.println(F("[CONFIG] ECC corrected bit errors"));
   }
   
-  return config_validate(cfg);
+  if (config_validate(cfg)) {
+    return true;
+  }
+  if (config_migrate_v1(cfg)) {
+    g_migrated = true;
+    return true;
+  }
+  return false;
 }
 
 bool config_validate(const Config_t* cfg) {
@@ -74,22 +152,45 @@ void config_load_defaults(Config_t* cfg) {
   cfg->servo_azimuth_offset = 0;
   cfg->servo_elevation_offset = 0;
   cfg->boot_count = 0;
+  
+  config_default_sensor_cal(cfg);
+  
+  cfg->site_latitude_cdeg = 0;
+  cfg->site_longitude_cdeg = 0;
+  cfg->mount_azimuth_deg = DEFAULT_MOUNT_AZIMUTH_DEG;
+  cfg->site_valid = 0;
+  
+  for (uint8_t axis = 0; axis < SERVO_AXIS_COUNT; axis++) {
+    cfg->servo_min_us[axis] = SERVO_DEFAULT_MIN_US;
+    cfg->servo_max_us[axis] = SERVO_DEFAULT_MAX_US;
+    cfg->servo_max_speed[axis] = SERVO_DEFAULT_SPEED_DPS * SERVO_CDEG_PER_DEG;
+    cfg->servo_max_accel[axis] = SERVO_DEFAULT_ACCEL_DPS2 * SERVO_CDEG_PER_DEG;
+  }
+  
+  cfg->telemetry_period_ms = TELEMETRY_DEFAULT_PERIOD_MS;
+  cfg->telemetry_groups = TELEM_GROUP_ALL;
+  
   cfg->crc16 = crc16(cfg, offsetof(Config_t, crc16));
 }
 
+void config_default_sensor_cal(Config_t* cfg) {
+  for (uint8_t ch = 0; ch < SENSOR_CH_COUNT; ch++) {
+    for (uint8_t k = 0; k < SENSOR_CAL_KNOTS; k++) {
+      uint32_t knot = (uint32_t)k << (16 - SENSOR_CAL_SEGMENT_BITS);
+      cfg->sensor_cal[ch][k] = (knot > 0xFFFF) ? 0xFFFF : (uint16_t)knot;
+    }
+  }
+}
+
 void config_manager_init() {
   Serial.println(F("\n=== SAFE BOOT SEQUENCE ==="));
   
-  Config_t primary, backup;
-  bool primary_valid = config_load(&primary, CONFIG_PRIMARY_ADDR);
-  bool backup_valid = config_load(&backup, CONFIG_BACKUP_ADDR);
-  
-  if (primary_valid) {
-    memcpy(&g_config, &primary, sizeof(Config_t));
+  // Decoded straight into g_config: the backup is only read if the primary
+  // fails, and no Config_t copy goes on the stack
+  if (config_load(&g_config, CONFIG_PRIMARY_ADDR)) {
     Serial.println(F("[BOOT] Primary config OK"));
   } 
-  else if (backup_valid) {
-    memcpy(&g_config, &backup, sizeof(Config_t));
+  else if (config_load(&g_config, CONFIG_BACKUP_ADDR)) {
     Serial.println(F("[BOOT] Primary corrupt, restored from backup"));
     config_save(&g_config, CONFIG_PRIMARY_ADDR);
     g_local_error_counts[ERR_PRIMARY_CONFIG_CORRUPT]++;
@@ -104,6 +205,13 @@ void config_manager_init() {
   
   memcpy(g_local_error_counts, g_config.error_counts, sizeof(g_local_error_counts));
   
+  if (g_migrated) {
+    // Rewritten by the background save once the scheduler runs; until it
+    // completes, a reset migrates the old image again
+    Serial.println(F("[BOOT] Config upgraded from version 1"));
+    config_mark_dirty();
+  }
+  
   Serial.print(F("[BOOT] Boot count: "));
   Serial.println(g_config.boot_count);
 }
@@ -117,13 +225,63 @@ Config_t* config_get_mutable() {
 }
 
 void config_persist() {
-  // Update error counts in config
-  memcpy(g_config.error_counts, g_local_error_counts, sizeof(g_config.error_counts));
-  
-  // Recalculate CRC
-  g_config.crc16 = crc16(&g_config, offsetof(Config_t, crc16));
+  config_seal();
   
-  // Write to both locations
+  // Write to both locations; supersedes any background save
   config_save(&g_config, CONFIG_PRIMARY_ADDR);
   config_save(&g_config, CONFIG_BACKUP_ADDR);
+  g_save_copies = 0;
+  g_save_restart = false;
+}
+
+void config_mark_dirty() {
+  if (g_save_copies > 0) {
+    g_save_restart = true;
+    return;
+  }
+  config_seal();
+  g_save_addr = CONFIG_PRIMARY_ADDR;
+  g_save_index = 0;
+  g_save_copies = 2;
+}
+
+bool config_save_step() {
+  if (g_save_copies == 0) {
+    return false;
+  }
+  
+  // The copy being written is torn but the other one is intact, so start
+  // this one over with the new contents and follow with the other
+  if (g_save_restart) {
+    config_seal();
+    g_save_index = 0;
+    g_save_copies = 2;
+    g_save_restart = false;
+  }
+  
+  if (!eeprom_is_ready()) {
+    return false;
+  }
+  
+  // Skip bytes that already match, stop at the first one that needs writing
+  for (uint8_t scanned = 0; scanned < CONFIG_SAVE_SCAN_BYTES &&
+       g_save_index < CONFIG_ENCODED_SIZE; scanned++) {
+    uint16_t addr = g_save_addr + g_save_index;
+    uint8_t encoded = config_encoded_byte(&g_config, g_save_index);
+    g_save_index++;
+    if (EEPROM.read(addr) != encoded) {
+      EEPROM.write(addr, encoded);   // Programs in the background (3.3 ms)
+      return false;
+    }
+  }
+  if (g_save_index < CONFIG_ENCODED_SIZE) {
+    return false;
+  }
+  
+  if (--g_save_copies > 0) {
+    g_save_addr = (g_save_addr == CONFIG_PRIMARY_ADDR) ? CONFIG_BACKUP_ADDR : CONFIG_PRIMARY_ADDR;
+    g_save_index = 0;
+    return false;
+  }
+  return true;
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+/**
+ * @file console.cpp
+ * @brief Deferred status line queue
+ *
+ * Entries hold pointers to flash strings plus one number, so a queued
+ * line costs 7 bytes of SRAM instead of its text. A line is only printed
+ * when the whole of it fits the TX ring, which keeps the drain task from
+ * blocking in Serial.write().
+ */
+
+#include "modules/console.h"
+#include "config.h"
+#include <Arduino.h>
+
+#define CONSOLE_VALUE_CHARS  5   // uint16_t in decimal
+
+typedef struct {
+  const __FlashStringHelper* text;
+  PGM_P name;                // Optional, nullptr if absent
+  uint16_t value;
+  bool has_value;
+} ConsoleLine_t;
+
+// Module state
+static ConsoleLine_t g_queue[CONSOLE_QUEUE_DEPTH];
+static uint8_t g_head = 0;
+static uint8_t g_count = 0;
+static uint16_t g_dropped = 0;
+static SerialStage_t g_stage;
+
+static void enqueue(const __FlashStringHelper* text, PGM_P name,
+                    uint16_t value, bool has_value) {
+  if (g_count >= CONSOLE_QUEUE_DEPTH) {
+    if (g_dropped < UINT16_MAX) {
+      g_dropped++;
+    }
+    return;
+  }
+  ConsoleLine_t* line = &g_queue[(g_head + g_count) % CONSOLE_QUEUE_DEPTH];
+  line->text = text;
+  line->name = name;
+  line->value = value;
+  line->has_value = has_value;
+  g_count++;
+}
+
+void console_post(const __FlashStringHelper* text) {
+  enqueue(text, nullptr, 0, false);
+}
+
+void console_post_value(const __FlashStringHelper* text, uint16_t value) {
+  enqueue(text, nullptr, value, true);
+}
+
+void console_post_named(const __FlashStringHelper* text, PGM_P name, uint16_t value) {
+  enqueue(text, name, value, true);
+}
+
+SerialStage_t& console_stage() {
+  return g_stage;
+}
+
+void console_flush_step() {
+  if (g_count == 0) {
+    if (g_dropped > 0) {
+      console_post_value(F("[CONSOLE] Lines dropped: "), g_dropped);
+      g_dropped = 0;
+    }
+    return;
+  }
+  
+  const ConsoleLine_t* line = &g_queue[g_head];
+  int length = strlen_P((PGM_P)line->text) + 2;   // CR LF
+  if (line->name != nullptr) {
+    length += strlen_P(line->name) + 1;
+  }
+  if (line->has_value) {
+    length += CONSOLE_VALUE_CHARS;
+  }
+  if (Serial.availableForWrite() < length) {
+    return;
+  }
+  
+  Serial.print(line->text);
+  if (line->name != nullptr) {
+    Serial.print((const __FlashStringHelper*)line->name);
+    Serial.print(' ');
+  }
+  if (line->has_value) {
+    Serial.print(line->value);
+  }
+  Serial.println();
+  
+  g_head = (g_head + 1) % CONSOLE_QUEUE_DEPTH;
+  g_count--;
+}
\ No newline at end of file
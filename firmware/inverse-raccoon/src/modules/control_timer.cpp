@@ -0,0 +1,156 @@
+/**
+ * @file control_timer.cpp
+ * @brief Timer2 control tick implementation
+ *
+ * Timer2 runs in CTC mode at F_CPU / 64 with OCR2A = 249, i.e. one compare
+ * match per millisecond and 4 us per count. Timer0 stays with millis() and
+ * Timer1 with the servos. Latency is measured from the hardware compare
+ * match that released the cycle, so it includes ISR entry and any time the
+ * control task waited behind other tasks.
+ */
+
+#include "modules/control_timer.h"
+#include "modules/scheduler.h"
+#include "config.h"
+#include <Arduino.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#define TIMER2_TOP                249     // 250 counts per 1 ms tick
+
+static_assert(F_CPU == 16000000UL, "Timer2 tick assumes a 16 MHz clock");
+static_assert(CONTROL_LOOP_RATE_HZ >= 1 && 1000 % CONTROL_LOOP_RATE_HZ == 0,
+              "Control rate must divide 1000 Hz evenly");
+
+static const uint16_t k_bucket_limits_us[CONTROL_JITTER_BUCKETS] PROGMEM = {
+  50, 100, 250, 500, 1000, 2500, 5000, 0
+};
+
+// Module state
+static volatile uint16_t g_ticks_since_release = 0;
+static volatile uint32_t g_tick_count = 0;        // Free-running, 1 ms per tick
+static uint8_t g_task_index = 0;
+static uint32_t g_cycle_start_us = 0;
+static ControlTiming_t g_timing;
+
+ISR(TIMER2_COMPA_vect) {
+  g_tick_count++;
+  if (++g_ticks_since_release >= CONTROL_LOOP_PERIOD_MS) {
+    g_ticks_since_release = 0;
+    scheduler_release(g_task_index);
+  }
+}
+
+/**
+ * @brief Microseconds since the last release, from the tick count and TCNT2
+ */
+static uint32_t time_since_release_us() {
+  uint16_t ticks;
+  uint8_t count;
+  
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    ticks = g_ticks_since_release;
+    count = TCNT2;
+    // Compare match already happened but its ISR has not run yet
+    if ((TIFR2 & _BV(OCF2A)) && count < TIMER2_TOP / 2) {
+      ticks++;
+    }
+  }
+  
+  return (uint32_t)ticks * 1000UL + (uint32_t)count * CONTROL_TIMESTAMP_US;
+}
+
+uint32_t control_timer_timestamp() {
+  uint32_t ticks;
+  uint8_t count;
+  
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    ticks = g_tick_count;
+    count = TCNT2;
+    if ((TIFR2 & _BV(OCF2A)) && count < TIMER2_TOP / 2) {
+      ticks++;
+    }
+  }
+  
+  return ticks * (TIMER2_TOP + 1) + count;
+}
+
+/**
+ * @brief Clamp a duration into a uint16_t statistic
+ */
+static uint16_t clamp_us(uint32_t us) {
+  return (us > UINT16_MAX) ? UINT16_MAX : (uint16_t)us;
+}
+
+void control_timer_init(uint8_t task_index) {
+  g_task_index = task_index;
+  control_timer_reset_stats();
+  
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    TCCR2B = 0;
+    ASSR = 0;                         // Synchronous clock
+    TCNT2 = 0;
+    OCR2A = TIMER2_TOP;
+    TCCR2A = _BV(WGM21);              // CTC, TOP = OCR2A
+    TIFR2 = _BV(OCF2A);               // Clear any stale match
+    TIMSK2 = _BV(OCIE2A);
+    TCCR2B = _BV(CS22);               // clk/64
+    g_ticks_since_release = 0;
+  }
+  
+  Serial.print(F("[TIMER] Control tick at "));
+  Serial.print(CONTROL_LOOP_RATE_HZ);
+  Serial.println(F(" Hz"));
+}
+
+void control_timer_begin_cycle() {
+  // The release this cycle serves was at most one period ago
+  uint16_t latency = clamp_us(time_since_release_us());
+  g_cycle_start_us = micros();
+  g_timing.last_latency_us = latency;
+  
+  if (latency < g_timing.latency_min_us) {
+    g_timing.latency_min_us = latency;
+  }
+  if (latency > g_timing.latency_max_us) {
+    g_timing.latency_max_us = latency;
+  }
+  g_timing.latency_sum_us += latency;
+  g_timing.cycles++;
+  
+  uint8_t bucket = 0;
+  while (bucket < CONTROL_JITTER_BUCKETS - 1 && latency >= pgm_read_word(&k_bucket_limits_us[bucket])) {
+    bucket++;
+  }
+  if (g_timing.histogram[bucket] < UINT16_MAX) {
+    g_timing.histogram[bucket]++;
+  }
+}
+
+void control_timer_end_cycle() {
+  uint16_t exec = clamp_us(micros() - g_cycle_start_us);
+  g_timing.last_exec_us = exec;
+  
+  if (exec < g_timing.exec_min_us) {
+    g_timing.exec_min_us = exec;
+  }
+  if (exec > g_timing.exec_max_us) {
+    g_timing.exec_max_us = exec;
+  }
+  g_timing.exec_sum_us += exec;
+}
+
+const ControlTiming_t* control_timer_get_stats() {
+  return &g_timing;
+}
+
+uint16_t control_timer_bucket_limit(uint8_t bucket) {
+  return (bucket < CONTROL_JITTER_BUCKETS) ? pgm_read_word(&k_bucket_limits_us[bucket]) : 0;
+}
+
+void control_timer_reset_stats() {
+  g_timing = ControlTiming_t();
+  g_timing.latency_min_us = UINT16_MAX;
+  g_timing.exec_min_us = UINT16_MAX;
+}
\ No newline at end of file
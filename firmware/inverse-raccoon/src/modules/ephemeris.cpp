@@ -0,0 +1,100 @@
+/**
+ * @file ephemeris.cpp
+ * @brief Fixed-point solar ephemeris implementation
+ */
+
+#include "modules/ephemeris.h"
+#include "modules/config_manager.h"
+#include "config.h"
+#include <Arduino.h>
+
+// Module state
+static uint32_t g_epoch_seconds = 0;   // Unix time at g_epoch_millis
+static uint32_t g_epoch_millis = 0;
+static bool g_time_valid = false;
+static SolarPosition_t g_cached_position;
+static uint32_t g_cached_at = 0;
+static bool g_cache_valid = false;
+
+void ephemeris_init() {
+  g_time_valid = false;
+  g_cache_valid = false;
+}
+
+void ephemeris_set_time(uint32_t unix_seconds) {
+  g_epoch_seconds = unix_seconds;
+  g_epoch_millis = millis();
+  g_time_valid = true;
+  g_cache_valid = false;
+}
+
+uint32_t ephemeris_get_time() {
+  if (!g_time_valid) {
+    return 0;
+  }
+  
+  // Move the anchor forward in whole seconds so millis() - g_epoch_millis
+  // never nears its 49.7-day wrap; the sub-second remainder carries over
+  uint32_t elapsed_ms = millis() - g_epoch_millis;
+  if (elapsed_ms >= EPHEMERIS_REANCHOR_MS) {
+    uint32_t whole_seconds = elapsed_ms / 1000;
+    g_epoch_seconds += whole_seconds;
+    g_epoch_millis += whole_seconds * 1000;
+    elapsed_ms -= whole_seconds * 1000;
+  }
+  return g_epoch_seconds + elapsed_ms / 1000;
+}
+
+bool ephemeris_is_valid() {
+  return g_time_valid && config_get()->site_valid;
+}
+
+void ephemeris_compute(uint32_t unix_seconds, SolarPosition_t* position) {
+  const Config_t* cfg = config_get();
+  solar_position(unix_seconds, cfg->site_latitude_cdeg, cfg->site_longitude_cdeg, position);
+}
+
+bool ephemeris_get_position(SolarPosition_t* position) {
+  if (!ephemeris_is_valid()) {
+    return false;
+  }
+  
+  uint32_t now = millis();
+  if (!g_cache_valid || now - g_cached_at >= EPHEMERIS_UPDATE_MS) {
+    ephemeris_compute(ephemeris_get_time(), &g_cached_position);
+    g_cached_at = now;
+    g_cache_valid = true;
+  }
+  
+  *position = g_cached_position;
+  return true;
+}
+
+bool ephemeris_to_servo(const SolarPosition_t* position, Angle_t* azimuth, Angle_t* elevation) {
+  static const Angle_t k_quarter = Angle_t::from_int(90);
+  static const Angle_t k_half = Angle_t::from_int(180);
+  static const Angle_t k_full = Angle_t::from_int(360);
+  
+  if (position->elevation <= Angle_t()) {
+    return false;
+  }
+  
+  // Bearing relative to the direction servo-center points at, (-180, 180]
+  Angle_t relative = position->azimuth - Angle_t::from_int(config_get()->mount_azimuth_deg);
+  while (relative > k_half) relative -= k_full;
+  while (relative <= -k_half) relative += k_full;
+  
+  if (relative.magnitude() <= k_quarter) {
+    *azimuth = k_quarter + relative;
+    *elevation = position->elevation;
+  } else {
+    // Behind the azimuth span: turn around and tip past zenith
+    relative += (relative > Angle_t()) ? -k_half : k_half;
+    *azimuth = k_quarter + relative;
+    *elevation = k_half - position->elevation;
+  }
+  
+  *azimuth = azimuth->clamp(Angle_t::from_int(MIN_AZIMUTH_DEG), Angle_t::from_int(MAX_AZIMUTH_DEG));
+  *elevation = elevation->clamp(Angle_t::from_int(MIN_ELEVATION_DEG), Angle_t::from_int(MAX_ELEVATION_DEG));
+  return true;
+}
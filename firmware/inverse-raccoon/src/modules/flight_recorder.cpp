@@ -0,0 +1,289 @@
+/**
+ * @file flight_recorder.cpp
+ * @brief Flight recorder implementation
+ *
+ * Each control cycle is bit-packed LSB-first into 14 bytes:
+ *
+ *   ldr x4      10 bits each   sensor counts, 10-bit scale
+ *   az, el      15 bits each   commanded centidegrees
+ *   mode         3             SystemMode_t
+ *   control      2             ControlMode_t
+ *   healthy      4             sensor healthy_mask
+ *   flags        3             FR_FLAG_*
+ *   sensor_err   3             saturating
+ *   servo_err    3             saturating
+ *   exec         9             control task execution, 64 us units
+ *   latency      7             release latency, 16 us units
+ *   seq          8             cycle counter, shows skipped cycles
+ *
+ * The ring keeps the last FLIGHT_RECORDER_RECORDS cycles. A trigger lets
+ * FLIGHT_RECORDER_POST_RECORDS more cycles in and then freezes the ring
+ * until REC ARM. Dumps go out a line at a time through the console's
+ * staging buffer so they never stall the control task.
+ *
+ * A calibration capture borrows the ring (flight_recorder_lend()); nothing
+ * is recorded until it hands it back.
+ */
+
+#include "modules/flight_recorder.h"
+#include "modules/console.h"
+#include "config.h"
+#include <Arduino.h>
+#include <string.h>
+
+#define FR_EXEC_SHIFT             6       // 64 us units
+#define FR_LATENCY_SHIFT          4       // 16 us units
+#define FR_LINE_SIZE              80      // Longest dump line, with margin
+
+static_assert(SERIAL_STAGING_SIZE >= FR_LINE_SIZE, "staging buffer must hold a dump line");
+
+// Field widths in packing order
+static const uint8_t k_field_bits[] PROGMEM = {
+  10, 10, 10, 10,   // ldr
+  15, 15,           // azimuth, elevation
+  3, 2, 4, 3,       // mode, control, healthy, flags
+  3, 3,             // sensor_err, servo_err
+  9, 7,             // exec, latency
+  8                 // seq
+};
+
+#define FR_FIELD_COUNT  (sizeof(k_field_bits) / sizeof(k_field_bits[0]))
+
+// Module state
+static uint8_t g_records[FLIGHT_RECORDER_RECORDS][FR_RECORD_BYTES];
+static uint8_t g_head = 0;                // Next slot to write
+static uint8_t g_count = 0;
+static uint8_t g_seq = 0;
+static FlightTrigger_t g_trigger = FR_TRIGGER_NONE;
+static uint8_t g_trigger_detail = 0;
+static uint8_t g_trigger_seq = 0;
+static uint32_t g_trigger_ms = 0;
+static uint8_t g_post_remaining = 0;
+static bool g_frozen = false;
+static bool g_lent = false;               // Ring holds a calibration capture
+static uint8_t g_dump_next = 0;           // Records already dumped, g_count + 1 once End is staged
+static bool g_dumping = false;            // Owns the staging buffer
+
+/**
+ * @brief Clamp a value to what fits in a field
+ */
+static uint16_t saturate(uint16_t value, uint8_t bits) {
+  uint16_t limit = (1U << bits) - 1;
+  return (value > limit) ? limit : value;
+}
+
+/**
+ * @brief Pack sample fields into a record
+ */
+static void record_pack(uint8_t* record, const uint16_t* fields) {
+  memset(record, 0, FR_RECORD_BYTES);
+  uint8_t pos = 0;
+  for (uint8_t f = 0; f < FR_FIELD_COUNT; f++) {
+    uint8_t bits = pgm_read_byte(&k_field_bits[f]);
+    uint16_t value = saturate(fields[f], bits);
+    for (uint8_t b = 0; b < bits; b++, pos++) {
+      if (value & (1U << b)) {
+        record[pos >> 3] |= (uint8_t)(1 << (pos & 7));
+      }
+    }
+  }
+}
+
+/**
+ * @brief Unpack a record into its fields
+ */
+static void record_unpack(const uint8_t* record, uint16_t* fields) {
+  uint8_t pos = 0;
+  for (uint8_t f = 0; f < FR_FIELD_COUNT; f++) {
+    uint8_t bits = pgm_read_byte(&k_field_bits[f]);
+    uint16_t value = 0;
+    for (uint8_t b = 0; b < bits; b++, pos++) {
+      if (record[pos >> 3] & (1 << (pos & 7))) {
+        value |= (1U << b);
+      }
+    }
+    fields[f] = value;
+  }
+}
+
+static_assert(FLIGHT_RECORDER_RECORDS <= 128, "record age must fit the 8-bit sequence");
+static_assert(sizeof(g_records) == FLIGHT_RECORDER_RING_BYTES, "record size mismatch");
+
+void flight_recorder_init() {
+  g_head = 0;
+  g_count = 0;
+  g_seq = 0;
+  g_trigger = FR_TRIGGER_NONE;
+  g_trigger_detail = 0;
+  g_post_remaining = 0;
+  g_frozen = false;
+  g_dumping = false;
+}
+
+void flight_recorder_log(const FlightSample_t* sample) {
+  if (g_frozen) {
+    return;
+  }
+  
+  uint16_t fields[FR_FIELD_COUNT] = {
+    sample->ldr[SENSOR_CH_TOPLEFT],
+    sample->ldr[SENSOR_CH_TOPRIGHT],
+    sample->ldr[SENSOR_CH_BOTTOMLEFT],
+    sample->ldr[SENSOR_CH_BOTTOMRIGHT],
+    sample->azimuth_cdeg,
+    sample->elevation_cdeg,
+    sample->mode,
+    sample->control_mode,
+    sample->healthy_mask,
+    sample->flags,
+    sample->sensor_errors,
+    sample->servo_errors,
+    (uint16_t)(sample->exec_us >> FR_EXEC_SHIFT),
+    (uint16_t)(sample->latency_us >> FR_LATENCY_SHIFT),
+    g_seq++
+  };
+  record_pack(g_records[g_head], fields);
+  
+  g_head = (g_head + 1) % FLIGHT_RECORDER_RECORDS;
+  if (g_count < FLIGHT_RECORDER_RECORDS) {
+    g_count++;
+  }
+  
+  if (g_trigger != FR_TRIGGER_NONE) {
+    if (g_post_remaining == 0) {
+      g_frozen = true;
+    } else {
+      g_post_remaining--;
+    }
+  }
+}
+
+void flight_recorder_trigger(FlightTrigger_t reason, uint8_t detail) {
+  if (g_trigger != FR_TRIGGER_NONE || reason == FR_TRIGGER_NONE) {
+    return;
+  }
+  g_trigger = reason;
+  g_trigger_detail = detail;
+  g_trigger_seq = g_seq;              // The cycle in progress is age 0
+  g_trigger_ms = millis();
+  g_post_remaining = FLIGHT_RECORDER_POST_RECORDS;
+}
+
+bool flight_recorder_rearm() {
+  if (g_lent) {
+    return false;
+  }
+  flight_recorder_init();
+  return true;
+}
+
+void* flight_recorder_lend() {
+  flight_recorder_init();
+  g_frozen = true;
+  g_lent = true;
+  memset(g_records, 0, sizeof(g_records));
+  return g_records;
+}
+
+void flight_recorder_reclaim() {
+  g_lent = false;
+  flight_recorder_init();
+}
+
+bool flight_recorder_is_frozen() {
+  return g_frozen;
+}
+
+void flight_recorder_print_status() {
+  Serial.print(F("[REC] "));
+  if (g_lent) {
+    Serial.println(F("Paused while calibrating"));
+    return;
+  }
+  Serial.print(g_frozen ? F("Frozen") : (g_trigger != FR_TRIGGER_NONE ? F("Triggered") : F("Recording")));
+  Serial.print(F(", "));
+  Serial.print(g_count);
+  Serial.print(F("/"));
+  Serial.print(FLIGHT_RECORDER_RECORDS);
+  Serial.print(F(" records at "));
+  Serial.print(CONTROL_LOOP_RATE_HZ);
+  Serial.print(F(" Hz"));
+  
+  if (g_trigger != FR_TRIGGER_NONE) {
+    Serial.print(F(", trigger "));
+    switch (g_trigger) {
+      case FR_TRIGGER_ERROR: Serial.print(F("ERR")); break;
+      case FR_TRIGGER_MODE: Serial.print(F("MODE")); break;
+      default: Serial.print(F("MANUAL")); break;
+    }
+    Serial.print(' ');
+    Serial.print(g_trigger_detail);
+    Serial.print(F(" at "));
+    Serial.print(g_trigger_ms);
+    Serial.print(F(" ms"));
+  }
+  Serial.println();
+}
+
+void flight_recorder_start_dump() {
+  if (g_trigger == FR_TRIGGER_NONE) {
+    flight_recorder_trigger(FR_TRIGGER_MANUAL, 0);
+  }
+  // Stop now rather than after the post-trigger cycles
+  g_frozen = true;
+  
+  flight_recorder_print_status();
+  Serial.println(F("[REC] age,tl,tr,bl,br,az_cdeg,el_cdeg,mode,ctrl,healthy,flags,sensor_err,servo_err,exec_us,lat_us"));
+  g_dump_next = 0;
+  console_stage().clear();
+  g_dumping = true;
+}
+
+bool flight_recorder_dump_step() {
+  if (!g_dumping) {
+    return false;
+  }
+  SerialStage_t& line = console_stage();
+  if (!line.drain(Serial)) {
+    return true;
+  }
+  if (g_dump_next > g_count) {
+    g_dumping = false;   // End line is out
+    return false;
+  }
+  
+  line.clear();
+  if (g_dump_next == g_count) {
+    line.println(F("[REC] End"));
+    g_dump_next++;
+    line.drain(Serial);
+    return true;
+  }
+  
+  // Oldest first
+  uint8_t slot = (g_head + FLIGHT_RECORDER_RECORDS - g_count + g_dump_next) % FLIGHT_RECORDER_RECORDS;
+  g_dump_next++;
+  
+  uint16_t fields[FR_FIELD_COUNT];
+  record_unpack(g_records[slot], fields);
+  
+  line.print(F("[REC] "));
+  line.print((int)(int8_t)((uint8_t)fields[FR_FIELD_COUNT - 1] - g_trigger_seq));
+  for (uint8_t f = 0; f < FR_FIELD_COUNT - 1; f++) {
+    uint16_t value = fields[f];
+    if (f == FR_FIELD_COUNT - 3) {
+      value <<= FR_EXEC_SHIFT;
+    } else if (f == FR_FIELD_COUNT - 2) {
+      value <<= FR_LATENCY_SHIFT;
+    }
+    line.print(',');
+    line.print(value);
+  }
+  line.println();
+  line.drain(Serial);
+  return true;
+}
+
+bool flight_recorder_is_dumping() {
+  return g_dumping;
+}
\ No newline at end of file
@@ -0,0 +1,220 @@
+/**
+ * @file journal.cpp
+ * @brief Fault journal implementation
+ *
+ * Records fill the EEPROM between JOURNAL_ADDR and E2END as a ring, so
+ * every slot takes the same share of erase/write cycles. The slot after
+ * the highest valid sequence number is the head; at boot that takes one
+ * pass over ~500 bytes and a CRC per slot.
+ *
+ * A record write costs 14 x 3.3 ms of EEPROM programming, so logging only
+ * queues the record in RAM and journal_service() writes one byte per call
+ * once the EEPROM is idle. The sequence number goes last: a write torn by
+ * a reset leaves a slot that fails its CRC and does not look like the head.
+ */
+
+#include "modules/journal.h"
+#include "modules/config_manager.h"
+#include "modules/console.h"
+#include "modules/safety_manager.h"
+#include "config.h"
+#include "utils/crc.h"
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <avr/eeprom.h>
+
+#define JOURNAL_RECORDS           ((E2END + 1 - JOURNAL_ADDR) / sizeof(JournalRecord_t))
+#define JOURNAL_LINE_SIZE         64
+
+static_assert(JOURNAL_ADDR >= CONFIG_BACKUP_ADDR + 2 * sizeof(Config_t),
+              "journal overlaps the backup config copy");
+static_assert(JOURNAL_RECORDS >= 8 && JOURNAL_RECORDS <= 255, "journal slot count out of range");
+static_assert(SERIAL_STAGING_SIZE >= JOURNAL_LINE_SIZE, "staging buffer must hold a dump line");
+
+// Module state
+static JournalRecord_t g_queue[JOURNAL_QUEUE_DEPTH];
+static uint8_t g_queue_head = 0;
+static uint8_t g_queue_count = 0;
+static uint8_t g_write_offset = 0;       // Bytes of the queue head already written
+static uint8_t g_slot = 0;               // Next slot to write (= oldest record)
+static uint8_t g_stored = 0;             // Valid records in EEPROM
+static uint16_t g_next_seq = 0;
+static uint8_t g_last_code = 0xFF;
+static uint32_t g_last_code_ms = 0;
+static uint16_t g_suppressed = 0;
+static uint16_t g_dropped = 0;
+static uint16_t g_dump_next = 0;         // Slots scanned, JOURNAL_RECORDS + 1 once End is staged
+static bool g_dumping = false;           // Owns the staging buffer
+
+/**
+ * @brief EEPROM address of a slot
+ */
+static uint16_t slot_addr(uint8_t slot) {
+  return JOURNAL_ADDR + slot * sizeof(JournalRecord_t);
+}
+
+/**
+ * @brief Read a slot
+ * @return true if its CRC checks
+ */
+static bool record_read(uint8_t slot, JournalRecord_t* record) {
+  EEPROM.get(slot_addr(slot), *record);
+  return crc16(record, offsetof(JournalRecord_t, crc16)) == record->crc16;
+}
+
+void journal_init(uint8_t reset_flags) {
+  bool found = false;
+  uint8_t newest = 0;
+  uint16_t newest_seq = 0;
+  g_stored = 0;
+  
+  for (uint8_t slot = 0; slot < JOURNAL_RECORDS; slot++) {
+    JournalRecord_t record;
+    if (!record_read(slot, &record)) {
+      continue;
+    }
+    g_stored++;
+    // Sequence numbers in the ring span far less than half the 16-bit range
+    if (!found || (int16_t)(record.seq - newest_seq) > 0) {
+      found = true;
+      newest = slot;
+      newest_seq = record.seq;
+    }
+  }
+  
+  g_slot = found ? (newest + 1) % JOURNAL_RECORDS : 0;
+  g_next_seq = found ? newest_seq + 1 : 0;
+  
+  Serial.print(F("[JOURNAL] "));
+  Serial.print(g_stored);
+  Serial.print(F(" records, next seq "));
+  Serial.println(g_next_seq);
+  
+  journal_log(JOURNAL_EVENT_BOOT, reset_flags);
+}
+
+void journal_log(uint8_t code, uint16_t context) {
+  uint32_t now = millis();
+  
+  // A fault that repeats every cycle would otherwise wear out the ring
+  if (code == g_last_code && code != JOURNAL_EVENT_BOOT &&
+      now - g_last_code_ms < JOURNAL_REPEAT_MS) {
+    g_suppressed++;
+    return;
+  }
+  if (g_queue_count >= JOURNAL_QUEUE_DEPTH) {
+    g_dropped++;
+    return;
+  }
+  g_last_code = code;
+  g_last_code_ms = now;
+  
+  JournalRecord_t* record = &g_queue[(g_queue_head + g_queue_count) % JOURNAL_QUEUE_DEPTH];
+  record->seq = g_next_seq++;
+  record->boot = (uint16_t)config_get()->boot_count;
+  record->uptime_ms = now;
+  record->code = code;
+  record->mode = (uint8_t)safety_get_mode();
+  record->context = context;
+  record->crc16 = crc16(record, offsetof(JournalRecord_t, crc16));
+  g_queue_count++;
+}
+
+void journal_service() {
+  if (g_queue_count == 0 || !eeprom_is_ready()) {
+    return;
+  }
+  
+  // Sequence number (offset 0) last
+  const uint8_t* bytes = (const uint8_t*)&g_queue[g_queue_head];
+  uint8_t index = (g_write_offset + sizeof(uint16_t)) % sizeof(JournalRecord_t);
+  EEPROM.update(slot_addr(g_slot) + index, bytes[index]);
+  
+  if (++g_write_offset < sizeof(JournalRecord_t)) {
+    return;
+  }
+  g_write_offset = 0;
+  g_slot = (g_slot + 1) % JOURNAL_RECORDS;
+  if (g_stored < JOURNAL_RECORDS) {
+    g_stored++;
+  }
+  g_queue_head = (g_queue_head + 1) % JOURNAL_QUEUE_DEPTH;
+  g_queue_count--;
+}
+
+void journal_print_status() {
+  Serial.print(F("[JOURNAL] "));
+  Serial.print(g_stored);
+  Serial.print(F("/"));
+  Serial.print(JOURNAL_RECORDS);
+  Serial.print(F(" records, next seq "));
+  Serial.print(g_next_seq);
+  Serial.print(F(", queued "));
+  Serial.print(g_queue_count);
+  Serial.print(F(", suppressed "));
+  Serial.print(g_suppressed);
+  Serial.print(F(", dropped "));
+  Serial.println(g_dropped);
+}
+
+void journal_start_dump() {
+  journal_print_status();
+  Serial.println(F("[JOURNAL] seq,boot,uptime_ms,code,mode,context"));
+  g_dump_next = 0;
+  console_stage().clear();
+  g_dumping = true;
+}
+
+bool journal_dump_step() {
+  if (!g_dumping) {
+    return false;
+  }
+  SerialStage_t& line = console_stage();
+  if (!line.drain(Serial)) {
+    return true;
+  }
+  if (g_dump_next > JOURNAL_RECORDS) {
+    g_dumping = false;   // End line is out
+    return false;
+  }
+  // Reading while a byte is being programmed would stall until it finishes
+  if (!eeprom_is_ready()) {
+    return true;
+  }
+  
+  line.clear();
+  
+  // Oldest first; empty and torn slots are skipped
+  JournalRecord_t record;
+  bool valid = false;
+  while (!valid && g_dump_next < JOURNAL_RECORDS) {
+    valid = record_read((g_slot + g_dump_next) % JOURNAL_RECORDS, &record);
+    g_dump_next++;
+  }
+  
+  if (!valid) {
+    line.println(F("[JOURNAL] End"));
+    g_dump_next = JOURNAL_RECORDS + 1;
+    line.drain(Serial);
+    return true;
+  }
+  
+  line.print(F("[JOURNAL] "));
+  line.print(record.seq);
+  line.print(',');
+  line.print(record.boot);
+  line.print(',');
+  line.print(record.uptime_ms);
+  line.print(',');
+  line.print(record.code);
+  line.print(',');
+  line.print(record.mode);
+  line.print(',');
+  line.println(record.context);
+  line.drain(Serial);
+  return true;
+}
+
+bool journal_is_dumping() {
+  return g_dumping;
+}
\ No newline at end of file
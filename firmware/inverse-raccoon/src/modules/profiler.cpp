@@ -0,0 +1,119 @@
+/**
+ * @file profiler.cpp
+ * @brief Per-stage profiling implementation
+ *
+ * Durations come from the free-running Timer2 timestamp (4 us = 64 CPU
+ * cycles per count), so recording costs two atomic timer reads and a few
+ * additions. Without PROFILING_ENABLED only the command-facing stubs remain.
+ */
+
+#include "modules/profiler.h"
+#include "config.h"
+#include <Arduino.h>
+
+#if PROFILING_ENABLED
+
+/**
+ * @brief Accumulated statistics for one stage (timestamp counts)
+ */
+typedef struct {
+  uint32_t count;
+  uint32_t sum;
+  uint16_t min;
+  uint16_t max;
+} StageStats_t;
+
+static const char k_name_control[] PROGMEM = "control";
+static const char k_name_command[] PROGMEM = "command";
+static const char k_name_sensor[] PROGMEM = "sensor";
+static const char k_name_position[] PROGMEM = "position";
+static const char k_name_tracking[] PROGMEM = "tracking";
+static const char k_name_servo[] PROGMEM = "servo";
+static const char k_name_safety[] PROGMEM = "safety";
+static const char k_name_scrub[] PROGMEM = "scrub";
+static const char k_name_telemetry[] PROGMEM = "telemetry";
+static const char k_name_config_save[] PROGMEM = "cfg_save";
+
+static const char* const k_stage_names[PROF_STAGE_COUNT] PROGMEM = {
+  k_name_control,
+  k_name_command,
+  k_name_sensor,
+  k_name_position,
+  k_name_tracking,
+  k_name_servo,
+  k_name_safety,
+  k_name_scrub,
+  k_name_telemetry,
+  k_name_config_save
+};
+
+// Module state
+static StageStats_t g_stages[PROF_STAGE_COUNT];
+static bool g_streaming = false;
+
+void profiler_record(uint8_t stage, uint32_t counts) {
+  if (stage >= PROF_STAGE_COUNT) {
+    return;
+  }
+  StageStats_t* stats = &g_stages[stage];
+  uint16_t sample = (counts > UINT16_MAX) ? UINT16_MAX : (uint16_t)counts;
+  
+  if (stats->count == 0 || sample < stats->min) {
+    stats->min = sample;
+  }
+  if (sample > stats->max) {
+    stats->max = sample;
+  }
+  stats->sum += counts;
+  stats->count++;
+}
+
+void profiler_print() {
+  Serial.println(F("[PROF] stage count min_us max_us mean_us"));
+  for (uint8_t i = 0; i < PROF_STAGE_COUNT; i++) {
+    const StageStats_t* stats = &g_stages[i];
+    Serial.print(F("  "));
+    Serial.print((const __FlashStringHelper*)pgm_read_ptr(&k_stage_names[i]));
+    Serial.print(' ');
+    Serial.print(stats->count);
+    Serial.print(' ');
+    Serial.print((uint32_t)stats->min * CONTROL_TIMESTAMP_US);
+    Serial.print(' ');
+    Serial.print((uint32_t)stats->max * CONTROL_TIMESTAMP_US);
+    Serial.print(' ');
+    Serial.println(stats->count ? (stats->sum / stats->count) * CONTROL_TIMESTAMP_US : 0);
+  }
+}
+
+void profiler_reset() {
+  for (uint8_t i = 0; i < PROF_STAGE_COUNT; i++) {
+    g_stages[i] = StageStats_t();
+  }
+}
+
+void profiler_set_streaming(bool enabled) {
+  g_streaming = enabled;
+}
+
+bool profiler_is_streaming() {
+  return g_streaming;
+}
+
+#else
+
+void profiler_print() {
+  Serial.println(F("[PROF] Profiling not built in (use the uno_profile environment)"));
+}
+
+void profiler_reset() {
+}
+
+void profiler_set_streaming(bool enabled) {
+  (void)enabled;
+}
+
+bool profiler_is_streaming() {
+  return false;
+}
+
+#endif
\ No newline at end of file
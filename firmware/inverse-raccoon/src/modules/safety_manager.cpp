@@ -6,6 +6,9 @@
 #include "modules/safety_manager.h"
 #include "modules/sensor_manager.h"
 #include "modules/servo_driver.h"
+#include "modules/flight_recorder.h"
+#include "modules/journal.h"
+#include "modules/console.h"
 #include "config.h"
 #include "utils/tmr.h"
 #include <Arduino.h>
@@ -33,13 +36,21 @@ void safety_evaluate_mode() {
   else if (servo_errors >= 1) {
     new_mode = MODE_DEGRADED_2;
   }
-  else if (sensor_errors >= 1) {
+  else if (sensor_errors >= 1 || 
+           !sensor_snapshot_is_fresh(SENSOR_SNAPSHOT_MAX_AGE_MS) ||
+           sensor_get_snapshot()->reading.healthy_mask != (1 << SENSOR_CH_COUNT) - 1) {
     new_mode = MODE_DEGRADED_1;
   }
   else if (g_error_counts[ERR_MEMORY_CORRUPTION] > MAX_ERROR_COUNT) {
     new_mode = MODE_SAFE;
   }
   
+  // Capture the lead-up to any drop into SAFE or EMERGENCY
+  if (new_mode >= MODE_SAFE && g_system_mode.vote() < MODE_SAFE) {
+    flight_recorder_trigger(FR_TRIGGER_MODE, new_mode);
+    journal_log(JOURNAL_EVENT_MODE, new_mode);
+  }
+  
   // Update mode with TMR
   g_system_mode.write(new_mode);
 }
@@ -47,16 +58,20 @@ void safety_evaluate_mode() {
 void safety_scrub_memory() {
   // Validate TMR variables
   if (!g_system_mode.validate()) {
-    Serial.println(F("[SAFETY] TMR corruption in system_mode"));
+    console_post(F("[SAFETY] TMR corruption in system_mode"));
     g_error_counts[ERR_MEMORY_CORRUPTION]++;
+    flight_recorder_trigger(FR_TRIGGER_ERROR, ERR_MEMORY_CORRUPTION);
+    journal_log(ERR_MEMORY_CORRUPTION, 0);
     g_system_mode.write(MODE_SAFE);
   }
 }
 
 bool safety_verify_control_flow(uint16_t signature) {
   if (signature != SIG_EXPECTED) {
-    Serial.println(F("[CRITICAL] Control flow corruption!"));
+    console_post(F("[CRITICAL] Control flow corruption!"));
     g_error_counts[ERR_CONTROL_FLOW]++;
+    flight_recorder_trigger(FR_TRIGGER_ERROR, ERR_CONTROL_FLOW);
+    journal_log(ERR_CONTROL_FLOW, signature);
     g_system_mode.write(MODE_SAFE);
     return false;
   }
@@ -74,6 +89,8 @@ void safety_set_mode(SystemMode_t mode) {
 void safety_log_error(ErrorCode_t error) {
   if (error >= 0 && error < ERR_COUNT) {
     g_error_counts[error]++;
+    flight_recorder_trigger(FR_TRIGGER_ERROR, error);
+    journal_log(error, g_error_counts[error]);
   }
 }
 
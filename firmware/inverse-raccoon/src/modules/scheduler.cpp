@@ -0,0 +1,249 @@
+/**
+ * @file scheduler.cpp
+ * @brief Cooperative scheduler implementation
+ *
+ * Releases are deadline-based: next_release advances by exactly one period
+ * per run, so timing does not drift with execution time. A task that falls
+ * more than a period behind drops the missed releases (counted as skipped)
+ * instead of bursting to catch up.
+ *
+ * Event tasks are released from interrupt context through a pending mask;
+ * their next_release is only an estimate (last start + period_ms) used to
+ * work out the slack available to lower-priority tasks.
+ */
+
+#include "modules/scheduler.h"
+#include "modules/console.h"
+#include "config.h"
+#include <Arduino.h>
+#include <util/atomic.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+/**
+ * @brief SRAM half of a task; the rest of its entry stays in PROGMEM
+ */
+typedef struct {
+  uint16_t period_ms;        // Current period
+  TaskStats_t stats;
+} TaskState_t;
+
+// Module state
+static const Task_t* g_tasks = nullptr;        // PROGMEM
+static TaskState_t g_state[SCHEDULER_MAX_TASKS];
+static uint8_t g_task_count = 0;
+static volatile uint8_t g_pending_events = 0;   // Bit per task index
+static uint32_t g_sleep_ms = 0;
+static uint16_t g_sleep_remainder_us = 0;
+static uint32_t g_stats_reset_time = 0;
+
+/**
+ * @brief Microseconds until the next release of any task above a priority
+ */
+static uint32_t slack_before(uint8_t priority, uint32_t now) {
+  uint32_t slack = UINT32_MAX;
+  for (uint8_t i = 0; i < g_task_count; i++) {
+    if (pgm_read_byte(&g_tasks[i].priority) >= priority) {
+      continue;
+    }
+    int32_t until = (int32_t)(g_state[i].stats.next_release - now);
+    if (until <= 0) {
+      return 0;
+    }
+    uint32_t until_us = (uint32_t)until * 1000UL;
+    if (until_us < slack) {
+      slack = until_us;
+    }
+  }
+  return slack;
+}
+
+/**
+ * @brief Whether a task is released and waiting to run
+ */
+static bool task_is_ready(const Task_t* task, uint8_t index, uint32_t now) {
+  if (task->trigger == TASK_EVENT) {
+    return (g_pending_events & (1 << index)) != 0;
+  }
+  return (int32_t)(now - g_state[index].stats.next_release) >= 0;
+}
+
+void scheduler_init(const Task_t* tasks, uint8_t count, uint32_t now) {
+  g_tasks = tasks;
+  g_task_count = (count > SCHEDULER_MAX_TASKS) ? SCHEDULER_MAX_TASKS : count;
+  g_pending_events = 0;
+  
+  for (uint8_t i = 0; i < g_task_count; i++) {
+    g_state[i].period_ms = pgm_read_word(&g_tasks[i].period_ms);
+    g_state[i].stats.next_release = now;
+  }
+  scheduler_reset_stats();
+  
+  Serial.print(F("[SCHED] Initialized with "));
+  Serial.print(g_task_count);
+  Serial.println(F(" tasks"));
+}
+
+bool scheduler_run() {
+  uint32_t now = millis();
+  
+  // Highest priority released task, earliest deadline first among equals
+  Task_t selected;
+  uint8_t selected_index = SCHEDULER_MAX_TASKS;
+  for (uint8_t i = 0; i < g_task_count; i++) {
+    Task_t task;
+    memcpy_P(&task, &g_tasks[i], sizeof(task));
+    if (!task_is_ready(&task, i, now)) {
+      continue;
+    }
+    if (selected_index == SCHEDULER_MAX_TASKS || task.priority < selected.priority ||
+        (task.priority == selected.priority &&
+         (int32_t)(g_state[i].stats.next_release - g_state[selected_index].stats.next_release) < 0)) {
+      selected = task;
+      selected_index = i;
+    }
+  }
+  
+  if (selected_index == SCHEDULER_MAX_TASKS) {
+    return false;
+  }
+  TaskState_t* state = &g_state[selected_index];
+  
+  // Background work must fit in the slack left before the control path,
+  // but a task postponed for a whole period runs anyway (no starvation)
+  if (selected.priority > 0 && selected.trigger == TASK_PERIODIC) {
+    bool starving = (now - state->stats.next_release) >= state->period_ms;
+    if (!starving && selected.budget_us > slack_before(selected.priority, now)) {
+      return false;
+    }
+  }
+  
+  if (selected.trigger == TASK_EVENT) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      g_pending_events &= ~(1 << selected_index);
+    }
+    state->stats.next_release = now + state->period_ms;
+  }
+  
+  uint32_t start_us = micros();
+  selected.run(now);
+  uint32_t exec_us = micros() - start_us;
+  
+  state->stats.run_count++;
+  if (exec_us > state->stats.max_exec_us) {
+    state->stats.max_exec_us = (exec_us > UINT16_MAX) ? UINT16_MAX : (uint16_t)exec_us;
+  }
+  if (exec_us > selected.budget_us) {
+    state->stats.overruns++;
+    if (selected.priority == 0) {
+      console_post_named(F("[WARNING] Task overrun (us): "), selected.name,
+                         (exec_us > UINT16_MAX) ? UINT16_MAX : (uint16_t)exec_us);
+    }
+  }
+  
+  if (selected.trigger == TASK_EVENT) {
+    return true;
+  }
+  
+  // Advance the deadline by whole periods, dropping any that already passed
+  state->stats.next_release += state->period_ms;
+  uint32_t after = millis();
+  while ((int32_t)(after - state->stats.next_release) >= (int32_t)state->period_ms) {
+    state->stats.next_release += state->period_ms;
+    state->stats.skipped++;
+  }
+  
+  return true;
+}
+
+void scheduler_idle() {
+#if IDLE_SLEEP_ENABLED
+  uint32_t start_us = micros();
+  
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  cli();
+  if (g_pending_events == 0) {
+    sleep_enable();
+    sei();          // The instruction after SEI always executes, so no wakeup is lost
+    sleep_cpu();
+    sleep_disable();
+  }
+  sei();
+  
+  uint32_t slept = micros() - start_us + g_sleep_remainder_us;
+  g_sleep_ms += slept / 1000;
+  g_sleep_remainder_us = slept % 1000;
+#endif
+}
+
+void scheduler_get_sleep_stats(uint32_t* sleep_ms, uint32_t* elapsed_ms) {
+  *sleep_ms = g_sleep_ms;
+  *elapsed_ms = millis() - g_stats_reset_time;
+}
+
+void scheduler_release(uint8_t index) {
+  if (index >= g_task_count) {
+    return;
+  }
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    if (g_pending_events & (1 << index)) {
+      g_state[index].stats.skipped++;
+    }
+    g_pending_events |= (1 << index);
+  }
+}
+
+void scheduler_set_period(uint8_t index, uint16_t period_ms) {
+  if (index >= g_task_count || period_ms == 0) {
+    return;
+  }
+  TaskState_t* state = &g_state[index];
+  state->period_ms = period_ms;
+  
+  uint32_t earliest = millis() + period_ms;
+  if (pgm_read_byte(&g_tasks[index].trigger) == TASK_PERIODIC &&
+      (int32_t)(state->stats.next_release - earliest) > 0) {
+    state->stats.next_release = earliest;
+  }
+}
+
+uint8_t scheduler_get_task_count() {
+  return g_task_count;
+}
+
+const Task_t* scheduler_get_task(uint8_t index) {
+  if (index >= g_task_count) {
+    return nullptr;
+  }
+  return &g_tasks[index];
+}
+
+uint16_t scheduler_get_period(uint8_t index) {
+  if (index >= g_task_count) {
+    return 0;
+  }
+  return g_state[index].period_ms;
+}
+
+const TaskStats_t* scheduler_get_stats(uint8_t index) {
+  if (index >= g_task_count) {
+    return nullptr;
+  }
+  return &g_state[index].stats;
+}
+
+void scheduler_reset_stats() {
+  g_sleep_ms = 0;
+  g_sleep_remainder_us = 0;
+  g_stats_reset_time = millis();
+  
+  for (uint8_t i = 0; i < g_task_count; i++) {
+    TaskStats_t* stats = &g_state[i].stats;
+    stats->run_count = 0;
+    stats->max_exec_us = 0;
+    stats->overruns = 0;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      stats->skipped = 0;   // Also written by scheduler_release()
+    }
+  }
+}
\ No newline at end of file
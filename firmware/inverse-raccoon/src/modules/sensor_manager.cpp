@@ -4,40 +4,476 @@
  */
 
 #include "modules/sensor_manager.h"
+#include "modules/config_manager.h"
+#include "modules/flight_recorder.h"
 #include "config.h"
+#include "utils/sample_filter.h"
+#include "utils/quadrant.h"
 #include <Arduino.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <util/atomic.h>
+
+static_assert(QUADRANT_TOPLEFT == SENSOR_CH_TOPLEFT && QUADRANT_TOPRIGHT == SENSOR_CH_TOPRIGHT &&
+              QUADRANT_BOTTOMLEFT == SENSOR_CH_BOTTOMLEFT && QUADRANT_BOTTOMRIGHT == SENSOR_CH_BOTTOMRIGHT &&
+              QUADRANT_COUNT == SENSOR_CH_COUNT, "quadrant order out of step with SENSOR_CH_*");
+
+/**
+ * @brief ADC slots serviced round-robin by the acquisition ISR
+ */
+enum {
+  ADC_SLOT_TOPLEFT = SENSOR_CH_TOPLEFT,
+  ADC_SLOT_TOPRIGHT = SENSOR_CH_TOPRIGHT,
+  ADC_SLOT_BOTTOMLEFT = SENSOR_CH_BOTTOMLEFT,
+  ADC_SLOT_BOTTOMRIGHT = SENSOR_CH_BOTTOMRIGHT,
+  ADC_SLOT_BATTERY = SENSOR_CH_COUNT,
+  ADC_SLOT_COUNT  // Must be last
+};
+
+/**
+ * @brief Per-channel health tracking state
+ */
+typedef struct {
+  uint16_t last_value;
+  uint8_t stuck_cycles;
+  uint8_t fail_cycles;
+  uint8_t clean_cycles;
+  SensorHealth_t health;
+} ChannelState_t;
+
+/**
+ * @brief Precomputed calibration slopes for one channel
+ *
+ * out = knot[seg] + slope[seg] * frac / 2^SENSOR_CAL_SHIFT, all in the
+ * 16-bit normalized domain, so the hot path is one lookup and one multiply.
+ * The knot outputs are read from the configuration rather than copied.
+ */
+typedef struct {
+  int16_t slope[SENSOR_CAL_SEGMENTS];
+} CalLut_t;
+
+/**
+ * @brief Capture accumulators for one channel
+ */
+typedef struct {
+  uint32_t reference_sum[SENSOR_CAL_KNOTS];
+  uint16_t count[SENSOR_CAL_KNOTS];
+} CalCapture_t;
+
+// Input bits below the segment index
+#define SENSOR_CAL_SHIFT       (16 - SENSOR_CAL_SEGMENT_BITS)
+
+// Reading at the configured resolution <-> 16-bit normalized domain
+#define SENSOR_TO_NORM(v)      ((uint16_t)((v) << (16 - SENSOR_RESOLUTION_BITS)))
+#define SENSOR_FROM_NORM(v)    ((uint16_t)((v) >> (16 - SENSOR_RESOLUTION_BITS)))
+
+// Analog pin -> ADC mux channel, indexed by slot
+static const uint8_t k_adc_channels[ADC_SLOT_COUNT] PROGMEM = {
+  SENSOR_PIN_TOPLEFT - A0,
+  SENSOR_PIN_TOPRIGHT - A0,
+  SENSOR_PIN_BOTTOMLEFT - A0,
+  SENSOR_PIN_BOTTOMRIGHT - A0,
+  BATTERY_VOLTAGE_PIN - A0
+};
+
+// Filter applied to each slot's sample block (FilterMode_t)
+static const uint8_t k_slot_filters[ADC_SLOT_COUNT] PROGMEM = {
+  SENSOR_FILTER_LDR,
+  SENSOR_FILTER_LDR,
+  SENSOR_FILTER_LDR,
+  SENSOR_FILTER_LDR,
+  SENSOR_FILTER_BATTERY
+};
+
+// AVcc reference, right-adjusted result
+#define ADC_MUX_BASE  _BV(REFS0)
+
+// Enabled, interrupt on completion, prescaler 128 (125 kHz ADC clock @ 16 MHz)
+#define ADC_CSR_BASE  (_BV(ADEN) | _BV(ADIE) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0))
+
+// Acquisition state (shared with ADC ISR)
+static volatile uint16_t g_samples[ADC_SLOT_COUNT][SENSOR_SAMPLE_COUNT];
+static volatile uint8_t g_adc_slot = 0;
+static volatile uint8_t g_ring_index = 0;
+static volatile uint8_t g_ring_fill = 0;
+
+// Oversampling burst state (shared with ADC ISR)
+static volatile bool g_burst_active = false;
+static volatile bool g_burst_ready = false;
+static volatile uint16_t g_burst_sample = 0;
+
+// 10-bit thresholds scaled to the configured resolution
+#define SENSOR_SCALED(counts)  ((uint16_t)(counts) << SENSOR_OVERSAMPLE_BITS)
+
+// Differential ADC counts -> degrees of pointing error
+// TODO: the scaling factor may need tuning
+static const Gain_t k_counts_to_degrees = Gain_t::from_float(1.0f / 10.0f);
 
 // Module state
+static ChannelState_t g_channels[SENSOR_CH_COUNT];
+static CalLut_t g_cal_lut[SENSOR_CH_COUNT];
+static CalCapture_t* g_cal_capture = nullptr;   // [SENSOR_CH_COUNT] in the recorder ring while capturing
+static bool g_cal_capturing = false;
+static SensorSnapshot_t g_snapshot;
 static SunPosition_t g_current_position;
 static uint16_t g_error_count = 0;
 
 /**
- * @brief Median of 3 values
+ * @brief ADC conversion complete - store sample and start the next slot
+ *
+ * Runs back-to-back conversions (~104 us each), so every slot's ring is
+ * refreshed roughly every 0.5 ms without involving the control loop.
  */
-static uint16_t median3(uint16_t a, uint16_t b, uint16_t c) {
-  if (a > b) {
-    if (b > c) return b;
-    else if (a > c) return c;
-    else return a;
-  } else {
-    if (a > c) return a;
-    else if (b > c) return c;
-    else return b;
+ISR(ADC_vect) {
+  if (g_burst_active) {
+    // Foreground burst owns the ADC; hand the result back, don't chain
+    g_burst_sample = ADCW;
+    g_burst_ready = true;
+    return;
+  }
+  
+  uint8_t slot = g_adc_slot;
+  g_samples[slot][g_ring_index] = ADCW;
+  
+  if (++slot >= ADC_SLOT_COUNT) {
+    slot = 0;
+    if (++g_ring_index >= SENSOR_SAMPLE_COUNT) {
+      g_ring_index = 0;
+    }
+    if (g_ring_fill < SENSOR_SAMPLE_COUNT) {
+      g_ring_fill++;
+    }
+  }
+  g_adc_slot = slot;
+  
+  // Mux change is safe here: no conversion is in progress
+  ADMUX = ADC_MUX_BASE | pgm_read_byte(&k_adc_channels[slot]);
+  ADCSRA = ADC_CSR_BASE | _BV(ADSC);
+}
+
+/**
+ * @brief Filter one slot of a ring snapshot (reorders the samples)
+ */
+static uint16_t sensor_filter_slot(uint8_t slot, uint16_t samples[SENSOR_SAMPLE_COUNT]) {
+  FilterMode_t mode = (FilterMode_t)pgm_read_byte(&k_slot_filters[slot]);
+  return filter_apply<SENSOR_SAMPLE_COUNT, SENSOR_FILTER_TRIM>(mode, samples);
+}
+
+/**
+ * @brief Copy the ISR sample rings without tearing
+ * @return true once every ring holds a full set of samples
+ */
+static bool sensor_snapshot_rings(uint16_t out[ADC_SLOT_COUNT][SENSOR_SAMPLE_COUNT]) {
+  bool primed;
+  
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    for (uint8_t slot = 0; slot < ADC_SLOT_COUNT; slot++) {
+      for (uint8_t i = 0; i < SENSOR_SAMPLE_COUNT; i++) {
+        out[slot][i] = g_samples[slot][i];
+      }
+    }
+    primed = (g_ring_fill >= SENSOR_SAMPLE_COUNT);
   }
+  
+  return primed;
 }
 
+#if SENSOR_OVERSAMPLE_BITS > 0
 /**
- * @brief Read single sensor with median filtering
+ * @brief One conversion with the CPU core asleep (SLEEP_MODE_IDLE)
+ *
+ * Not ADC Noise Reduction: that mode halts clkI/O, which would stop
+ * Timer1 (servo PWM), Timer2 (control tick) and Timer0 (millis) for the
+ * whole burst. IDLE only stops the CPU, so the timers and UART run on and
+ * their interrupts wake us early; we go back to sleep until the ADC ISR
+ * hands over the result.
  */
-static uint16_t sensor_read_filtered(uint8_t pin) {
-  uint16_t samples[SENSOR_SAMPLE_COUNT];
+static uint16_t sensor_convert_quiet() {
+  g_burst_ready = false;
+  ADCSRA = ADC_CSR_BASE | _BV(ADSC);
   
-  for (uint8_t i = 0; i < SENSOR_SAMPLE_COUNT; i++) {
-    samples[i] = analogRead(pin);
-    delayMicroseconds(100);
+  cli();
+  while (!g_burst_ready) {
+    sleep_enable();
+    sei();          // The instruction after SEI always executes, so no wakeup is lost
+    sleep_cpu();
+    sleep_disable();
+    cli();
   }
+  sei();
   
-  return median3(samples[0], samples[1], samples[2]);
+  return g_burst_sample;
+}
+
+/**
+ * @brief Oversample and decimate the LDR slots
+ *
+ * Pauses the background engine, takes 4^k conversions per LDR and keeps
+ * the sum scaled to 10 + k bits, then restarts the engine.
+ */
+static void sensor_oversample_ldrs(uint16_t out[ADC_SLOT_BATTERY]) {
+  const uint16_t samples_per_slot = (uint16_t)1 << (2 * SENSOR_OVERSAMPLE_BITS);
+  
+  // Let the in-flight background conversion land in the burst slot
+  g_burst_active = true;
+  while (ADCSRA & _BV(ADSC)) {
+  }
+  
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  
+  for (uint8_t slot = 0; slot < ADC_SLOT_BATTERY; slot++) {
+    ADMUX = ADC_MUX_BASE | pgm_read_byte(&k_adc_channels[slot]);
+    
+    // Discard first conversion after the mux switch (input settling)
+    sensor_convert_quiet();
+    
+    uint32_t sum = 0;
+    for (uint16_t i = 0; i < samples_per_slot; i++) {
+      sum += sensor_convert_quiet();
+    }
+    
+    // 4^k samples -> k extra bits
+    out[slot] = oversample_decimate<SENSOR_OVERSAMPLE_BITS>(sum);
+  }
+  
+  // Resume the background engine where it left off
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    g_burst_active = false;
+    ADMUX = ADC_MUX_BASE | pgm_read_byte(&k_adc_channels[g_adc_slot]);
+    ADCSRA = ADC_CSR_BASE | _BV(ADSC);
+  }
+}
+#endif
+
+/**
+ * @brief Run stuck-at, range, rate and consistency checks on one cycle
+ * @param v Filtered channel values at the configured resolution
+ * @return Bitmask of channels currently trusted
+ */
+static uint8_t sensor_update_health(const uint16_t v[SENSOR_CH_COUNT]) {
+  uint16_t delta[SENSOR_CH_COUNT];
+  uint16_t normalized[SENSOR_CH_COUNT];
+  bool all_low = true;
+  bool all_high = true;
+  uint8_t trusted = 0;
+  
+  for (uint8_t ch = 0; ch < SENSOR_CH_COUNT; ch++) {
+    uint16_t last = g_channels[ch].last_value;
+    delta[ch] = (v[ch] > last) ? v[ch] - last : last - v[ch];
+    normalized[ch] = v[ch] >> SENSOR_OVERSAMPLE_BITS;
+    all_low &= (v[ch] <= SENSOR_SCALED(SENSOR_RAIL_LOW));
+    all_high &= (v[ch] >= SENSOR_SCALED(SENSOR_RAIL_HIGH));
+    if (g_channels[ch].health == SENSOR_HEALTH_OK) {
+      trusted++;
+    }
+  }
+  
+  // The cross-product check needs all four channels to mean anything
+  uint8_t suspect = (trusted == SENSOR_CH_COUNT) ? 
+                    quadrant_find_inconsistent(normalized) : (uint8_t)SENSOR_CH_COUNT;
+  
+  uint8_t mask = 0;
+  
+  for (uint8_t ch = 0; ch < SENSOR_CH_COUNT; ch++) {
+    ChannelState_t* state = &g_channels[ch];
+    
+    bool others_moving = false;
+    bool others_jumped = false;
+    for (uint8_t other = 0; other < SENSOR_CH_COUNT; other++) {
+      if (other == ch) continue;
+      others_moving |= (delta[other] > SENSOR_SCALED(SENSOR_STUCK_NOISE));
+      others_jumped |= (delta[other] > SENSOR_SCALED(SENSOR_MAX_STEP / 2));
+    }
+    
+    // Stuck-at: frozen while the scene changes around it
+    if (delta[ch] <= SENSOR_SCALED(SENSOR_STUCK_NOISE) && others_moving) {
+      if (state->stuck_cycles < 255) state->stuck_cycles++;
+    } else if (delta[ch] > SENSOR_SCALED(SENSOR_STUCK_NOISE)) {
+      state->stuck_cycles = 0;
+    }
+    
+    SensorHealth_t fault = SENSOR_HEALTH_OK;
+    uint8_t persist = SENSOR_FAULT_PERSIST;
+    
+    if ((v[ch] <= SENSOR_SCALED(SENSOR_RAIL_LOW) && !all_low) ||
+        (v[ch] >= SENSOR_SCALED(SENSOR_RAIL_HIGH) && !all_high)) {
+      fault = SENSOR_HEALTH_RANGE;
+    } else if (delta[ch] > SENSOR_SCALED(SENSOR_MAX_STEP) && !others_jumped) {
+      // Glitch: drop it this cycle, no need to wait
+      fault = SENSOR_HEALTH_RATE;
+      persist = 1;
+    } else if (state->stuck_cycles >= SENSOR_STUCK_CYCLES) {
+      fault = SENSOR_HEALTH_STUCK;
+      persist = 1;
+    } else if (ch == suspect) {
+      fault = SENSOR_HEALTH_INCONSISTENT;
+    }
+    
+    if (fault != SENSOR_HEALTH_OK) {
+      state->clean_cycles = 0;
+      if (state->fail_cycles < 255) state->fail_cycles++;
+      if (state->fail_cycles >= persist) {
+        state->health = fault;
+      }
+    } else {
+      state->fail_cycles = 0;
+      if (state->clean_cycles < 255) state->clean_cycles++;
+      if (state->clean_cycles >= SENSOR_RECOVERY_CYCLES) {
+        state->health = SENSOR_HEALTH_OK;
+      }
+    }
+    
+    state->last_value = v[ch];
+    
+    if (state->health == SENSOR_HEALTH_OK) {
+      mask |= (1 << ch);
+    }
+  }
+  
+  return mask;
+}
+
+/**
+ * @brief Map a raw reading through the channel's calibration curve
+ */
+static uint16_t sensor_apply_calibration(uint8_t ch, uint16_t raw) {
+  uint16_t x = SENSOR_TO_NORM(raw);
+  uint8_t seg = x >> SENSOR_CAL_SHIFT;
+  uint16_t frac = x & ((1U << SENSOR_CAL_SHIFT) - 1);
+  uint16_t base = config_get()->sensor_cal[ch][seg];
+  
+  int32_t out = base + (((int32_t)g_cal_lut[ch].slope[seg] * frac) >> SENSOR_CAL_SHIFT);
+  out = constrain(out, 0, 0xFFFF);
+  
+  return SENSOR_FROM_NORM((uint16_t)out);
+}
+
+/**
+ * @brief Accumulate one capture sample per channel against the mean
+ *
+ * Assumes all four cells see the same (diffused) light during the sweep,
+ * so the four-channel mean is the reference each channel is matched to.
+ */
+static void sensor_cal_accumulate(const uint16_t raw[SENSOR_CH_COUNT]) {
+  uint32_t reference = 0;
+  for (uint8_t ch = 0; ch < SENSOR_CH_COUNT; ch++) {
+    reference += SENSOR_TO_NORM(raw[ch]);
+  }
+  reference /= SENSOR_CH_COUNT;
+  
+  for (uint8_t ch = 0; ch < SENSOR_CH_COUNT; ch++) {
+    // Nearest knot to this channel's own reading
+    uint32_t x = SENSOR_TO_NORM(raw[ch]);
+    uint8_t knot = (x + (1UL << (SENSOR_CAL_SHIFT - 1))) >> SENSOR_CAL_SHIFT;
+    
+    CalCapture_t* cap = &g_cal_capture[ch];
+    if (cap->count[knot] < 0xFFFF) {
+      cap->reference_sum[knot] += reference;
+      cap->count[knot]++;
+    }
+  }
+}
+
+void sensor_reload_calibration() {
+  const Config_t* cfg = config_get();
+  
+  for (uint8_t ch = 0; ch < SENSOR_CH_COUNT; ch++) {
+    for (uint8_t seg = 0; seg < SENSOR_CAL_SEGMENTS; seg++) {
+      int32_t slope = (int32_t)cfg->sensor_cal[ch][seg + 1] - cfg->sensor_cal[ch][seg];
+      g_cal_lut[ch].slope[seg] = (int16_t)constrain(slope, INT16_MIN, INT16_MAX);
+    }
+  }
+}
+
+static_assert(SENSOR_CH_COUNT * sizeof(CalCapture_t) <= FLIGHT_RECORDER_RING_BYTES,
+              "calibration capture does not fit the flight recorder ring");
+
+void sensor_cal_start() {
+  // Capture runs only during CAL, so it borrows the recorder's SRAM
+  g_cal_capture = (CalCapture_t*)flight_recorder_lend();
+  g_cal_capturing = true;
+}
+
+void sensor_cal_abort() {
+  if (g_cal_capturing) {
+    g_cal_capturing = false;
+    flight_recorder_reclaim();
+  }
+}
+
+bool sensor_cal_is_capturing() {
+  return g_cal_capturing;
+}
+
+bool sensor_cal_finish() {
+  uint16_t knots[SENSOR_CH_COUNT][SENSOR_CAL_KNOTS];
+  
+  // A rejected fit leaves the capture running so the sweep can continue
+  if (!g_cal_capturing) {
+    return false;
+  }
+  
+  for (uint8_t ch = 0; ch < SENSOR_CH_COUNT; ch++) {
+    const CalCapture_t* cap = &g_cal_capture[ch];
+    bool present[SENSOR_CAL_KNOTS];
+    uint8_t present_count = 0;
+    
+    for (uint8_t k = 0; k < SENSOR_CAL_KNOTS; k++) {
+      present[k] = (cap->count[k] >= SENSOR_CAL_MIN_SAMPLES);
+      if (present[k]) {
+        knots[ch][k] = cap->reference_sum[k] / cap->count[k];
+        present_count++;
+      }
+    }
+    
+    // A curve needs at least two points of the sweep
+    if (present_count < 2) {
+      return false;
+    }
+    
+    // Fill gaps: interpolate inside the swept range, carry the nearest
+    // knot's offset from identity outside it
+    for (uint8_t k = 0; k < SENSOR_CAL_KNOTS; k++) {
+      if (present[k]) continue;
+      
+      int8_t lo = k - 1;
+      while (lo >= 0 && !present[lo]) lo--;
+      uint8_t hi = k + 1;
+      while (hi < SENSOR_CAL_KNOTS && !present[hi]) hi++;
+      
+      int32_t identity = (int32_t)k << SENSOR_CAL_SHIFT;
+      int32_t value;
+      if (lo >= 0 && hi < SENSOR_CAL_KNOTS) {
+        value = knots[ch][lo] + ((int32_t)knots[ch][hi] - knots[ch][lo]) * (k - lo) / (hi - lo);
+      } else {
+        uint8_t n = (lo >= 0) ? (uint8_t)lo : hi;
+        value = identity + ((int32_t)knots[ch][n] - ((int32_t)n << SENSOR_CAL_SHIFT));
+      }
+      knots[ch][k] = (uint16_t)constrain(value, 0, 0xFFFF);
+    }
+    
+    // Keep the curve monotonic so ordering of light levels survives
+    for (uint8_t k = 1; k < SENSOR_CAL_KNOTS; k++) {
+      if (knots[ch][k] < knots[ch][k - 1]) {
+        knots[ch][k] = knots[ch][k - 1];
+      }
+    }
+  }
+  
+  sensor_cal_abort();
+  Config_t* cfg = config_get_mutable();
+  memcpy(cfg->sensor_cal, knots, sizeof(cfg->sensor_cal));
+  config_mark_dirty();
+  sensor_reload_calibration();
+  
+  return true;
+}
+
+void sensor_cal_reset() {
+  sensor_cal_abort();
+  config_default_sensor_cal(config_get_mutable());
+  config_mark_dirty();
+  sensor_reload_calibration();
 }
 
 void sensor_manager_init() {
@@ -46,29 +482,79 @@ void sensor_manager_init() {
   // pinMode(SENSOR_PIN_BOTTOMLEFT, INPUT_PULLUP);
   // pinMode(SENSOR_PIN_BOTTOMRIGHT, INPUT_PULLUP);
 
-  g_current_position.azimuth_error = 0;
-  g_current_position.elevation_error = 0;
+  g_current_position.azimuth_error = Angle_t();
+  g_current_position.elevation_error = Angle_t();
   g_current_position.sun_detected = false;
   g_error_count = 0;
+  memset(&g_snapshot, 0, sizeof(g_snapshot));
+  memset(g_channels, 0, sizeof(g_channels));
+  g_cal_capturing = false;
+  sensor_reload_calibration();
+  
+  // Start the background acquisition engine. From here on the ADC belongs
+  // to the ISR, so analogRead() must not be used on any slot pin.
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    g_adc_slot = 0;
+    g_ring_index = 0;
+    g_ring_fill = 0;
+    ADMUX = ADC_MUX_BASE | pgm_read_byte(&k_adc_channels[0]);
+    ADCSRA = ADC_CSR_BASE | _BV(ADSC);
+  }
 }
 
-bool sensor_read_all(SensorReading_t* reading) {
+/**
+ * @brief Filter and validate all sensors from the ISR sample rings
+ */
+static bool sensor_read_all(SensorReading_t* reading) {
+  uint16_t samples[ADC_SLOT_COUNT][SENSOR_SAMPLE_COUNT];
+  
   reading->timestamp = millis();
+  reading->resolution_bits = SENSOR_RESOLUTION_BITS;
+  
+  if (!sensor_snapshot_rings(samples)) {
+    // Rings still filling after init - not a sensor fault
+    reading->valid = false;
+    return false;
+  }
+  
+#if SENSOR_OVERSAMPLE_BITS > 0
+  uint16_t ldr[ADC_SLOT_BATTERY];
+  sensor_oversample_ldrs(ldr);
   
-  reading->top_left = sensor_read_filtered(SENSOR_PIN_TOPLEFT);
-  reading->top_right = sensor_read_filtered(SENSOR_PIN_TOPRIGHT);
-  reading->bottom_left = sensor_read_filtered(SENSOR_PIN_BOTTOMLEFT);
-  reading->bottom_right = sensor_read_filtered(SENSOR_PIN_BOTTOMRIGHT);
+  reading->top_left = ldr[ADC_SLOT_TOPLEFT];
+  reading->top_right = ldr[ADC_SLOT_TOPRIGHT];
+  reading->bottom_left = ldr[ADC_SLOT_BOTTOMLEFT];
+  reading->bottom_right = ldr[ADC_SLOT_BOTTOMRIGHT];
+#else
+  reading->top_left = sensor_filter_slot(ADC_SLOT_TOPLEFT, samples[ADC_SLOT_TOPLEFT]);
+  reading->top_right = sensor_filter_slot(ADC_SLOT_TOPRIGHT, samples[ADC_SLOT_TOPRIGHT]);
+  reading->bottom_left = sensor_filter_slot(ADC_SLOT_BOTTOMLEFT, samples[ADC_SLOT_BOTTOMLEFT]);
+  reading->bottom_right = sensor_filter_slot(ADC_SLOT_BOTTOMRIGHT, samples[ADC_SLOT_BOTTOMRIGHT]);
+#endif
   
   // Validate sensor readings
-  uint8_t fault_count = 0;
+  const uint16_t values[SENSOR_CH_COUNT] = {
+    reading->top_left, reading->top_right,
+    reading->bottom_left, reading->bottom_right
+  };
+  reading->healthy_mask = sensor_update_health(values);
+  
+  // Capture sees raw responses; everything downstream sees matched ones
+  if (g_cal_capturing) {
+    sensor_cal_accumulate(values);
+  }
   
-  if (reading->top_left < SENSOR_MIN_VALUE || reading->top_left > SENSOR_MAX_VALUE) fault_count++;
-  if (reading->top_right < SENSOR_MIN_VALUE || reading->top_right > SENSOR_MAX_VALUE) fault_count++;
-  if (reading->bottom_left < SENSOR_MIN_VALUE || reading->bottom_left > SENSOR_MAX_VALUE) fault_count++;
-  if (reading->bottom_right < SENSOR_MIN_VALUE || reading->bottom_right > SENSOR_MAX_VALUE) fault_count++;
+  reading->top_left = sensor_apply_calibration(SENSOR_CH_TOPLEFT, values[SENSOR_CH_TOPLEFT]);
+  reading->top_right = sensor_apply_calibration(SENSOR_CH_TOPRIGHT, values[SENSOR_CH_TOPRIGHT]);
+  reading->bottom_left = sensor_apply_calibration(SENSOR_CH_BOTTOMLEFT, values[SENSOR_CH_BOTTOMLEFT]);
+  reading->bottom_right = sensor_apply_calibration(SENSOR_CH_BOTTOMRIGHT, values[SENSOR_CH_BOTTOMRIGHT]);
   
-  reading->valid = (fault_count < 2);  // Allow operation with 1 faulty sensor
+  uint8_t healthy = 0;
+  for (uint8_t ch = 0; ch < SENSOR_CH_COUNT; ch++) {
+    if (reading->healthy_mask & (1 << ch)) healthy++;
+  }
+  
+  reading->valid = (healthy >= SENSOR_CH_COUNT - 1);  // Allow operation with 1 faulty sensor
   
   if (!reading->valid) {
     g_error_count++;
@@ -77,32 +563,83 @@ bool sensor_read_all(SensorReading_t* reading) {
   return reading->valid;
 }
 
+const SensorSnapshot_t* sensor_acquire() {
+  sensor_read_all(&g_snapshot.reading);
+  g_snapshot.generation++;
+  
+  return &g_snapshot;
+}
+
+const SensorSnapshot_t* sensor_get_snapshot() {
+  return &g_snapshot;
+}
+
+bool sensor_snapshot_is_fresh(uint32_t max_age_ms) {
+  if (g_snapshot.generation == 0) {
+    return false;
+  }
+  
+  return (millis() - g_snapshot.reading.timestamp) <= max_age_ms;
+}
+
 void sensor_calculate_position(const SensorReading_t* reading, SunPosition_t* position) {
-  // Calculate average light intensity
-  uint32_t total = reading->top_left + reading->top_right + 
-                   reading->bottom_left + reading->bottom_right;
-  uint16_t average = total / 4;
+  const int32_t tl = reading->top_left;
+  const int32_t tr = reading->top_right;
+  const int32_t bl = reading->bottom_left;
+  const int32_t br = reading->bottom_right;
+  const int32_t values[SENSOR_CH_COUNT] = { tl, tr, bl, br };
+  const uint8_t mask = reading->healthy_mask;
+  const uint8_t all = (1 << SENSOR_CH_COUNT) - 1;
+  uint8_t extra_bits = reading->resolution_bits - SENSOR_ADC_BITS;
+  
+  // Calculate average light intensity over trusted channels
+  uint32_t total = 0;
+  uint8_t healthy = 0;
+  for (uint8_t ch = 0; ch < SENSOR_CH_COUNT; ch++) {
+    if (mask & (1 << ch)) {
+      total += values[ch];
+      healthy++;
+    }
+  }
+  uint16_t average = healthy ? total / healthy : 0;
   
   // Detect if sun is visible 
   // TODO: the threshold may need tuning, idk what ambient light levels are like
-  position->sun_detected = (average > SUN_TRESHOLD);
+  position->sun_detected = (healthy >= SENSOR_CH_COUNT - 1) &&
+                           (average > ((uint16_t)SUN_TRESHOLD << extra_bits));
   
   if (!position->sun_detected) {
-    position->azimuth_error = 0;
-    position->elevation_error = 0;
+    position->azimuth_error = Angle_t();
+    position->elevation_error = Angle_t();
     return;
   }
   
-  // Calculate differential errors
-  int16_t horizontal_diff = (reading->top_right + reading->bottom_right) - 
-                            (reading->top_left + reading->bottom_left);
-  int16_t vertical_diff = (reading->top_left + reading->top_right) - 
-                          (reading->bottom_left + reading->bottom_right);
+  // Calculate differential errors (extra oversampling bits act as fraction).
+  // With one quadrant down, each axis uses the row/column that is still
+  // complete, doubled to match the two-pair scale.
+  int32_t horizontal_diff;
+  int32_t vertical_diff;
+  
+  if (mask == all) {
+    horizontal_diff = (tr + br) - (tl + bl);
+    vertical_diff = (tl + tr) - (bl + br);
+  } else if (!(mask & (1 << SENSOR_CH_TOPLEFT))) {
+    horizontal_diff = 2 * (br - bl);
+    vertical_diff = 2 * (tr - br);
+  } else if (!(mask & (1 << SENSOR_CH_TOPRIGHT))) {
+    horizontal_diff = 2 * (br - bl);
+    vertical_diff = 2 * (tl - bl);
+  } else if (!(mask & (1 << SENSOR_CH_BOTTOMLEFT))) {
+    horizontal_diff = 2 * (tr - tl);
+    vertical_diff = 2 * (tr - br);
+  } else {
+    horizontal_diff = 2 * (tr - tl);
+    vertical_diff = 2 * (tl - bl);
+  }
   
-  // Normalize to degree,
-  // TODO: the scaling factor may need tuning
-  position->azimuth_error =  horizontal_diff / 10.0f;
-  position->elevation_error = vertical_diff / 10.0f;
+  // Normalize to degrees
+  position->azimuth_error = Angle_t::product(horizontal_diff, k_counts_to_degrees, extra_bits);
+  position->elevation_error = Angle_t::product(vertical_diff, k_counts_to_degrees, extra_bits);
   
   // Cache current position
   g_current_position = *position;
@@ -112,6 +649,23 @@ const SunPosition_t* sensor_get_position() {
   return &g_current_position;
 }
 
+uint16_t sensor_read_battery() {
+  uint16_t samples[ADC_SLOT_COUNT][SENSOR_SAMPLE_COUNT];
+  
+  if (!sensor_snapshot_rings(samples)) {
+    return 0;
+  }
+  
+  return sensor_filter_slot(ADC_SLOT_BATTERY, samples[ADC_SLOT_BATTERY]);
+}
+
+SensorHealth_t sensor_get_channel_health(uint8_t channel) {
+  if (channel >= SENSOR_CH_COUNT) {
+    return SENSOR_HEALTH_OK;
+  }
+  return g_channels[channel].health;
+}
+
 uint16_t sensor_get_error_count() {
   return g_error_count;
 }
@@ -1,57 +1,445 @@
 /**
  * @file servo_driver.cpp
  * @brief Servo control implementation
+ *
+ * servo_execute_command() only validates and latches targets. The planner in
+ * servo_driver_tick() moves each axis toward its target along a trapezoidal
+ * velocity profile (accelerate, cruise, brake) and writes the pulse width.
+ * Position is kept in 0.001 centidegree so that, with velocity in
+ * centidegrees per second, one millisecond of travel is simply velocity.
+ *
+ * An axis that has sat at its target for SERVO_IDLE_SETTLE_MS stops being
+ * pulsed (and, with SERVO_POWER_PIN, the supply is switched off once both
+ * are idle). Commands within SERVO_REATTACH_CDEG of a detached axis are
+ * absorbed; larger moves reattach it transparently.
  */
 
 #include "modules/servo_driver.h"
+#include "modules/config_manager.h"
+#include "modules/console.h"
 #include "config.h"
 #include "utils/crc.h"
+
+#if SERVO_BACKEND == SERVO_BACKEND_TIMER1
+#include <avr/io.h>
+#include <util/atomic.h>
+#else
 #include <Servo.h>
+#endif
+
+static const uint8_t k_servo_pins[SERVO_AXIS_COUNT] = {
+  SERVO_AZIMUTH_PIN,
+  SERVO_ELEVATION_PIN
+};
+
+#define MOTION_SCALE              1000L   // Planner position units per centidegree
+
+/**
+ * @brief Per-axis planner state
+ */
+typedef struct {
+  int32_t position;     // Centidegrees * MOTION_SCALE
+  int32_t velocity;     // Centidegrees per second (signed)
+  uint16_t target;      // Centidegrees
+  uint16_t written_us;  // Last pulse width sent to the backend
+  uint32_t settled_ms;  // Time spent at target since the last move
+  bool attached;
+} AxisMotion_t;
 
 // Module state
-static Servo g_servo_azimuth;
-static Servo g_servo_elevation;
+static AxisMotion_t g_motion[SERVO_AXIS_COUNT];
+static uint32_t g_last_tick_time = 0;
+static ServoPowerStats_t g_power;
+static uint16_t g_charge_remainder = 0;   // mA*ms not yet rolled into charge_mas
 static uint16_t g_error_count = 0;
 
+#if SERVO_BACKEND == SERVO_BACKEND_TIMER1
+
+// Timer1 runs at F_CPU / 8 = 2 MHz, so one count is 0.5 us
+#define TIMER1_COUNTS_PER_US      2
+
+static_assert(SERVO_AZIMUTH_PIN == 9 && SERVO_ELEVATION_PIN == 10,
+              "Timer1 backend drives OC1A (pin 9) and OC1B (pin 10) only");
+static_assert((uint32_t)SERVO_FRAME_US * TIMER1_COUNTS_PER_US - 1 <= 0xFFFF,
+              "Servo frame does not fit Timer1");
+
+static const uint8_t k_compare_outputs[SERVO_AXIS_COUNT] = {
+  _BV(COM1A1),
+  _BV(COM1B1)
+};
+
+/**
+ * @brief Fast PWM mode 14 (TOP = ICR1); outputs stay disconnected until attach
+ */
+static void backend_init() {
+  for (uint8_t axis = 0; axis < SERVO_AXIS_COUNT; axis++) {
+    digitalWrite(k_servo_pins[axis], LOW);
+    pinMode(k_servo_pins[axis], OUTPUT);
+  }
+  
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    TCCR1B = 0;                 // Stop while reconfiguring
+    TIMSK1 = 0;                 // No Timer1 interrupts at all
+    TCNT1 = 0;
+    ICR1 = (uint16_t)(SERVO_FRAME_US * TIMER1_COUNTS_PER_US - 1);
+    OCR1A = 0;
+    OCR1B = 0;
+    TCCR1A = _BV(WGM11);
+    TCCR1B = _BV(WGM13) | _BV(WGM12) | _BV(CS11);
+  }
+}
+
+/**
+ * @brief Set pulse width; OCR1x is double-buffered and latches at BOTTOM
+ */
+static void backend_write_us(uint8_t axis, uint16_t us) {
+  uint16_t counts = us * TIMER1_COUNTS_PER_US;
+  
+  // 16-bit register writes share the TEMP byte with any other Timer1 access
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    if (axis == SERVO_AXIS_AZIMUTH) {
+      OCR1A = counts;
+    } else {
+      OCR1B = counts;
+    }
+  }
+}
+
+/**
+ * @brief Load the pulse width, then connect the compare output to the pin
+ */
+static void backend_attach(uint8_t axis, uint16_t us) {
+  backend_write_us(axis, us);
+  TCCR1A |= k_compare_outputs[axis];
+}
+
+/**
+ * @brief Disconnect the compare output; the pin falls back to PORT (low)
+ */
+static void backend_detach(uint8_t axis) {
+  TCCR1A &= ~k_compare_outputs[axis];
+}
+
+#else
+
+static Servo g_servos[SERVO_AXIS_COUNT];
+
+static void backend_init() {
+}
+
+static void backend_write_us(uint8_t axis, uint16_t us) {
+  g_servos[axis].writeMicroseconds(us);
+}
+
+/**
+ * @brief Attach the Servo library with the widest limits; the per-axis
+ * calibration does the real mapping
+ */
+static void backend_attach(uint8_t axis, uint16_t us) {
+  g_servos[axis].attach(k_servo_pins[axis], SERVO_PULSE_LIMIT_MIN_US, SERVO_PULSE_LIMIT_MAX_US);
+  g_servos[axis].writeMicroseconds(us);
+}
+
+static void backend_detach(uint8_t axis) {
+  g_servos[axis].detach();
+}
+
+#endif
+
+/**
+ * @brief Centidegrees -> pulse width using the axis endpoint calibration
+ */
+static uint16_t servo_cdeg_to_us(uint8_t axis, uint16_t cdeg) {
+  const Config_t* cfg = config_get();
+  int32_t span = (int32_t)cfg->servo_max_us[axis] - cfg->servo_min_us[axis];
+  const int32_t full_scale = (int32_t)SERVO_MAX_DEG * SERVO_CDEG_PER_DEG;
+  
+  return cfg->servo_min_us[axis] + (span * cdeg + full_scale / 2) / full_scale;
+}
+
+/**
+ * @brief Start pulsing an axis (and power the servo rail if gated)
+ */
+static void axis_attach(uint8_t axis) {
+  AxisMotion_t* motion = &g_motion[axis];
+  if (motion->attached) {
+    return;
+  }
+#ifdef SERVO_POWER_PIN
+  digitalWrite(SERVO_POWER_PIN, HIGH);
+#endif
+  backend_attach(axis, motion->written_us);
+  motion->attached = true;
+  motion->settled_ms = 0;
+  g_power.attached_mask |= (1 << axis);
+}
+
+/**
+ * @brief Stop pulsing an axis; gate the rail once no axis needs it
+ */
+static void axis_detach(uint8_t axis) {
+  AxisMotion_t* motion = &g_motion[axis];
+  if (!motion->attached) {
+    return;
+  }
+  backend_detach(axis);
+  motion->attached = false;
+  g_power.attached_mask &= ~(1 << axis);
+#ifdef SERVO_POWER_PIN
+  if (g_power.attached_mask == 0) {
+    digitalWrite(SERVO_POWER_PIN, LOW);
+  }
+#endif
+}
+
+/**
+ * @brief Advance one axis along its trapezoidal profile
+ * @param motion Axis state
+ * @param max_speed Cruise speed limit, 0.01 deg/s (0 = jump)
+ * @param max_accel Acceleration limit, 0.01 deg/s^2 (0 = jump)
+ * @param dt_ms Time since the last step
+ */
+static void motion_step(AxisMotion_t* motion, uint16_t max_speed, uint16_t max_accel,
+                        uint16_t dt_ms) {
+  int32_t target = (int32_t)motion->target * MOTION_SCALE;
+  int32_t error = target - motion->position;
+  
+  if (error == 0 && motion->velocity == 0) {
+    return;
+  }
+  if (max_speed == 0 || max_accel == 0) {
+    motion->position = target;
+    motion->velocity = 0;
+    return;
+  }
+  
+  uint32_t distance = (uint32_t)(error < 0 ? -error : error) / MOTION_SCALE;
+  uint32_t speed = (uint32_t)(motion->velocity < 0 ? -motion->velocity : motion->velocity);
+  bool toward = (motion->velocity == 0) || ((motion->velocity > 0) == (error > 0));
+  uint32_t dv = ((uint32_t)max_accel * dt_ms + 500) / 1000;
+  if (dv == 0) {
+    dv = 1;
+  }
+  
+  // Brake if moving away, or if the stopping distance (plus one step of
+  // lookahead for the discrete update) reaches the target
+  uint32_t stopping = (speed * speed) / (2UL * max_accel) + (speed * dt_ms) / 1000;
+  if (!toward || stopping >= distance) {
+    speed = (speed > dv) ? speed - dv : 0;
+  } else {
+    speed += dv;
+    if (speed > max_speed) {
+      speed = max_speed;
+    }
+  }
+  
+  // Braking against the old direction keeps its sign until it reaches zero
+  bool positive = toward ? (error > 0) : (motion->velocity > 0);
+  motion->velocity = positive ? (int32_t)speed : -(int32_t)speed;
+  
+  int32_t step = motion->velocity * dt_ms;
+  int32_t remaining = error < 0 ? -error : error;
+  if (toward && (step < 0 ? -step : step) >= remaining) {
+    // Arrive without overshoot
+    motion->position = target;
+    motion->velocity = 0;
+  } else {
+    motion->position += step;
+  }
+}
+
+/**
+ * @brief Current planner position in centidegrees (rounded)
+ */
+static uint16_t motion_position_cdeg(const AxisMotion_t* motion) {
+  return (uint16_t)((motion->position + MOTION_SCALE / 2) / MOTION_SCALE);
+}
+
 void servo_driver_init() {
-  g_servo_azimuth.attach(SERVO_AZIMUTH_PIN);
-  g_servo_elevation.attach(SERVO_ELEVATION_PIN);
+#ifdef SERVO_POWER_PIN
+  pinMode(SERVO_POWER_PIN, OUTPUT);
+#endif
+  backend_init();
   
-  // Move to default position
-  g_servo_azimuth.write(DEFAULT_AZIMUTH_DEG);
-  g_servo_elevation.write(DEFAULT_ELEVATION_DEG);
+  // Start at the default position; the real angle is unknown at power-up,
+  // so this first move is not profiled
+  g_power = ServoPowerStats_t();
+  g_charge_remainder = 0;
+  g_motion[SERVO_AXIS_AZIMUTH].target = DEFAULT_AZIMUTH_DEG * SERVO_CDEG_PER_DEG;
+  g_motion[SERVO_AXIS_ELEVATION].target = DEFAULT_ELEVATION_DEG * SERVO_CDEG_PER_DEG;
+  for (uint8_t axis = 0; axis < SERVO_AXIS_COUNT; axis++) {
+    AxisMotion_t* motion = &g_motion[axis];
+    motion->position = (int32_t)motion->target * MOTION_SCALE;
+    motion->velocity = 0;
+    motion->written_us = servo_cdeg_to_us(axis, motion->target);
+    motion->attached = false;
+    axis_attach(axis);
+  }
+  g_last_tick_time = millis();
   
   g_error_count = 0;
   
+#if SERVO_BACKEND == SERVO_BACKEND_TIMER1
+  Serial.println(F("[SERVO] Initialized (Timer1 hardware PWM)"));
+#else
   Serial.println(F("[SERVO] Initialized"));
+#endif
 }
 
 bool servo_execute_command(const ServoCommand_t* cmd) {
   // Validate CRC
   uint16_t computed_crc = crc16(cmd, offsetof(ServoCommand_t, crc16));
   if (computed_crc != cmd->crc16) {
-    Serial.println(F("[SERVO] CRC mismatch"));
+    console_post(F("[SERVO] CRC mismatch"));
     g_error_count++;
     return false;
   }
   
   // Validate range - use physical servo limits
-  if (cmd->azimuth < SERVO_MIN_DEG || cmd->azimuth > SERVO_MAX_DEG) {
-    Serial.print(F("[SERVO] Azimuth out of range: "));
-    Serial.println(cmd->azimuth);
+  if (cmd->azimuth_cdeg < SERVO_MIN_DEG * SERVO_CDEG_PER_DEG ||
+      cmd->azimuth_cdeg > SERVO_MAX_DEG * SERVO_CDEG_PER_DEG) {
+    console_post_value(F("[SERVO] Azimuth out of range (cdeg): "), cmd->azimuth_cdeg);
     g_error_count++;
     return false;
   }
-  if (cmd->elevation < SERVO_MIN_DEG || cmd->elevation > SERVO_MAX_DEG) {
-    Serial.print(F("[SERVO] Elevation out of range: "));
-    Serial.println(cmd->elevation);
+  if (cmd->elevation_cdeg < SERVO_MIN_DEG * SERVO_CDEG_PER_DEG ||
+      cmd->elevation_cdeg > SERVO_MAX_DEG * SERVO_CDEG_PER_DEG) {
+    console_post_value(F("[SERVO] Elevation out of range (cdeg): "), cmd->elevation_cdeg);
     g_error_count++;
     return false;
   }
   
-  // Execute command
-  g_servo_azimuth.write(cmd->azimuth);
-  g_servo_elevation.write(cmd->elevation);
+  // Latch targets; servo_driver_tick() moves toward them
+  const uint16_t targets[SERVO_AXIS_COUNT] = { cmd->azimuth_cdeg, cmd->elevation_cdeg };
+  for (uint8_t axis = 0; axis < SERVO_AXIS_COUNT; axis++) {
+    AxisMotion_t* motion = &g_motion[axis];
+    if (!motion->attached) {
+      // Small corrections are not worth waking a parked servo for
+      int32_t delta = (int32_t)targets[axis] - motion_position_cdeg(motion);
+      if (delta <= SERVO_REATTACH_CDEG && delta >= -SERVO_REATTACH_CDEG) {
+        continue;
+      }
+      axis_attach(axis);
+    }
+    if (targets[axis] != motion->target) {
+      motion->target = targets[axis];
+      motion->settled_ms = 0;
+    }
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Charge and duty accounting for one planner step
+ */
+static void account_power(uint16_t dt_ms) {
+  uint32_t current_ma = 0;
+  for (uint8_t axis = 0; axis < SERVO_AXIS_COUNT; axis++) {
+    if (!g_motion[axis].attached) {
+      current_ma += SERVO_IDLE_CURRENT_MA;
+    } else {
+      g_power.attached_ms[axis] += dt_ms;
+      current_ma += servo_is_in_motion(axis) ? SERVO_MOVE_CURRENT_MA : SERVO_HOLD_CURRENT_MA;
+    }
+  }
+  g_power.elapsed_ms += dt_ms;
+  
+  uint32_t charge = current_ma * dt_ms + g_charge_remainder;
+  g_power.charge_mas += charge / 1000;
+  g_charge_remainder = charge % 1000;
+}
+
+void servo_driver_tick(uint32_t now) {
+  uint32_t elapsed = now - g_last_tick_time;
+  if (elapsed == 0) {
+    return;
+  }
+  g_last_tick_time = now;
+  uint16_t dt_ms = (elapsed > SERVO_TICK_MAX_MS) ? SERVO_TICK_MAX_MS : (uint16_t)elapsed;
+  
+  const Config_t* cfg = config_get();
+  for (uint8_t axis = 0; axis < SERVO_AXIS_COUNT; axis++) {
+    AxisMotion_t* motion = &g_motion[axis];
+    motion_step(motion, cfg->servo_max_speed[axis], cfg->servo_max_accel[axis], dt_ms);
+    
+    uint16_t us = servo_cdeg_to_us(axis, motion_position_cdeg(motion));
+    if (us != motion->written_us) {
+      motion->written_us = us;
+      if (motion->attached) {
+        backend_write_us(axis, us);
+      }
+    }
+    
+    // Idle policy: park the axis once it has held its target long enough
+    if (motion->attached && !servo_is_in_motion(axis)) {
+      motion->settled_ms += dt_ms;
+      if (motion->settled_ms >= SERVO_IDLE_SETTLE_MS) {
+        axis_detach(axis);
+      }
+    }
+  }
+  
+  account_power(dt_ms);
+}
+
+void servo_get_power_stats(ServoPowerStats_t* stats) {
+  *stats = g_power;
+}
+
+bool servo_is_in_motion(uint8_t axis) {
+  if (axis >= SERVO_AXIS_COUNT) {
+    return false;
+  }
+  const AxisMotion_t* motion = &g_motion[axis];
+  return motion->velocity != 0 ||
+         motion->position != (int32_t)motion->target * MOTION_SCALE;
+}
+
+bool servo_at_target() {
+  for (uint8_t axis = 0; axis < SERVO_AXIS_COUNT; axis++) {
+    if (servo_is_in_motion(axis)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void servo_get_position(ServoCommand_t* position) {
+  position->azimuth_cdeg = motion_position_cdeg(&g_motion[SERVO_AXIS_AZIMUTH]);
+  position->elevation_cdeg = motion_position_cdeg(&g_motion[SERVO_AXIS_ELEVATION]);
+  position->crc16 = crc16(position, offsetof(ServoCommand_t, crc16));
+}
+
+bool servo_set_motion_limits(uint8_t axis, uint16_t max_speed, uint16_t max_accel) {
+  if (axis >= SERVO_AXIS_COUNT ||
+      max_speed > SERVO_MAX_SPEED_DPS * SERVO_CDEG_PER_DEG ||
+      max_accel > SERVO_MAX_ACCEL_DPS2 * SERVO_CDEG_PER_DEG) {
+    return false;
+  }
+  
+  Config_t* cfg = config_get_mutable();
+  cfg->servo_max_speed[axis] = max_speed;
+  cfg->servo_max_accel[axis] = max_accel;
+  config_mark_dirty();
+  
+  return true;
+}
+
+bool servo_set_endpoints(uint8_t axis, uint16_t min_us, uint16_t max_us) {
+  // Either order is valid (reversed servo), so range-check both ends
+  uint16_t lo = (min_us < max_us) ? min_us : max_us;
+  uint16_t hi = (min_us < max_us) ? max_us : min_us;
+  if (axis >= SERVO_AXIS_COUNT ||
+      lo < SERVO_PULSE_LIMIT_MIN_US || hi > SERVO_PULSE_LIMIT_MAX_US ||
+      lo == hi) {
+    return false;
+  }
+  
+  Config_t* cfg = config_get_mutable();
+  cfg->servo_min_us[axis] = min_us;
+  cfg->servo_max_us[axis] = max_us;
+  config_mark_dirty();
   
   return true;
 }
@@ -1,32 +1,49 @@
 /**
  * @file telemetry.cpp
- * @brief Telemetry and diagnostics implementation with JSON output
+ * @brief Telemetry and diagnostics implementation with JSON and binary output
+ *
+ * Frames go out through a staging buffer drained without blocking; see
+ * "Frame staging" below.
  */
 
 #include "modules/telemetry.h"
 #include "modules/safety_manager.h"
 #include "modules/sensor_manager.h"
 #include "modules/servo_driver.h"
+#include "modules/control_timer.h"
+#include "modules/scheduler.h"
+#include "modules/config_manager.h"
+#include "modules/console.h"
 #include "config.h"
+#include "protocol.h"
+#include "utils/cobs.h"
+#include "utils/crc.h"
 #include <Arduino.h>
+#include <string.h>
+
+static_assert(TELEM_CHANNELS == SENSOR_CH_COUNT, "protocol.h channel count mismatch");
+static_assert(TELEM_AXES == SERVO_AXIS_COUNT, "protocol.h axis count mismatch");
+static_assert(TELEM_JITTER_BUCKETS == CONTROL_JITTER_BUCKETS, "protocol.h histogram mismatch");
+static_assert(TELEM_ANGLE_FRAC == 6, "protocol.h angle format must match Angle_t");
 
 // Module state
 static bool g_led_state = false;
 static uint32_t g_telemetry_counter = 0;
+static TelemetryFormat_t g_format = TELEMETRY_FORMAT_JSON;
 
 void telemetry_init() {
   pinMode(LED_HEARTBEAT_PIN, OUTPUT);
   Serial.begin(115200);  // Increased baud rate for faster data
   
   Serial.println(F("\n\n================================="));
-  Serial.println(" ________  ___   __    __   __   ______   ______    ______   ______       ______    ________   ______   ______   ______   ______   ___   __      ");
-  Serial.println("/_______/\\/__/\\ /__/\\ /_/\\ /_/\\ /_____/\\ /_____/\\  /_____/\\ /_____/\\     /_____/\\  /_______/\\ /_____/\\ /_____/\\ /_____/\\ /_____/\\ /__/\\ /__/\\    ");
-  Serial.println("\\__.::._\\/\\::\\_\\\\  \\ \\\\:\\ \\\\ \\ \\\\::::_\\/_\\:::_ \\ \\ \\::::_\\/_\\::::_\\/_    \\:::_ \\ \\ \\::: _  \\ \\\\:::__\\/ \\:::__\\/ \\:::_ \\ \\\\:::_ \\ \\\\::\\_\\\\  \\ \\   ");
-  Serial.println("   \\::\\ \\  \\:. `-\\  \\ \\\\:\\ \\\\ \\ \\\\:\\/___/\\\\:(_) ) )_\\:\\/___/\\\\:\\/___/\\    \\:(_) ) )_\\::(_)  \\ \\\\:\\ \\  __\\:\\ \\  __\\:\\ \\ \\ \\\\:\\ \\ \\ \\\\:. `-\\  \\ \\  ");
-  Serial.println("   _\\::\\ \\__\\:. _    \\ \\\\:\\_/.:\\ \\\\::___\\/_\\: __ `\\ \\\\_::._\\:\\\\::___\\/_    \\: __ `\\ \\\\:: __  \\ \\\\:\\ \\/_/\\\\:\\ \\/_/\\\\:\\ \\ \\ \\\\:\\ \\ \\ \\\\:. _    \\ \\ ");
-  Serial.println("  /__\\::\\__/\\\\. \\`-\\  \\ \\\\ ..::/ / \\:\\____/\\\\ \\ `\\ \\ \\ /____\\:\\\\:\\____/\\    \\ \\ `\\ \\ \\\\:.\\ \\  \\ \\\\:\\_\\ \\ \\\\:\\_\\ \\ \\\\:\\_\\ \\ \\\\:\\_\\ \\ \\\\. \\`-\\  \\ \\");
-  Serial.println("  \\________\\/ \\__\\/ \\__\\/ \\___/_(   \\_____\\/ \\_\\/ \\_\\/ \\_____\\/ \\_____\\/     \\_\\/ \\_\\/ \\__\\/\\__\\/ \\_____\\/ \\_____\\/ \\_____\\/ \\_____\\/ \\__\\/ \\__\\/");
-  Serial.println("");
+  Serial.println(F(" ________  ___   __    __   __   ______   ______    ______   ______       ______    ________   ______   ______   ______   ______   ___   __      "));
+  Serial.println(F("/_______/\\/__/\\ /__/\\ /_/\\ /_/\\ /_____/\\ /_____/\\  /_____/\\ /_____/\\     /_____/\\  /_______/\\ /_____/\\ /_____/\\ /_____/\\ /_____/\\ /__/\\ /__/\\    "));
+  Serial.println(F("\\__.::._\\/\\::\\_\\\\  \\ \\\\:\\ \\\\ \\ \\\\::::_\\/_\\:::_ \\ \\ \\::::_\\/_\\::::_\\/_    \\:::_ \\ \\ \\::: _  \\ \\\\:::__\\/ \\:::__\\/ \\:::_ \\ \\\\:::_ \\ \\\\::\\_\\\\  \\ \\   "));
+  Serial.println(F("   \\::\\ \\  \\:. `-\\  \\ \\\\:\\ \\\\ \\ \\\\:\\/___/\\\\:(_) ) )_\\:\\/___/\\\\:\\/___/\\    \\:(_) ) )_\\::(_)  \\ \\\\:\\ \\  __\\:\\ \\  __\\:\\ \\ \\ \\\\:\\ \\ \\ \\\\:. `-\\  \\ \\  "));
+  Serial.println(F("   _\\::\\ \\__\\:. _    \\ \\\\:\\_/.:\\ \\\\::___\\/_\\: __ `\\ \\\\_::._\\:\\\\::___\\/_    \\: __ `\\ \\\\:: __  \\ \\\\:\\ \\/_/\\\\:\\ \\/_/\\\\:\\ \\ \\ \\\\:\\ \\ \\ \\\\:. _    \\ \\ "));
+  Serial.println(F("  /__\\::\\__/\\\\. \\`-\\  \\ \\\\ ..::/ / \\:\\____/\\\\ \\ `\\ \\ \\ /____\\:\\\\:\\____/\\    \\ \\ `\\ \\ \\\\:.\\ \\  \\ \\\\:\\_\\ \\ \\\\:\\_\\ \\ \\\\:\\_\\ \\ \\\\:\\_\\ \\ \\\\. \\`-\\  \\ \\"));
+  Serial.println(F("  \\________\\/ \\__\\/ \\__\\/ \\___/_(   \\_____\\/ \\_\\/ \\_\\/ \\_____\\/ \\_____\\/     \\_\\/ \\_\\/ \\__\\/\\__\\/ \\_____\\/ \\_____\\/ \\_____\\/ \\_____\\/ \\__\\/ \\__\\/"));
+  Serial.println();
   Serial.println(F("Space.Apps.Ottawa 2025"));
   Serial.println(F("================================="));
 }
@@ -79,11 +96,55 @@ void telemetry_print_sensors(const SensorReading_t* reading) {
   Serial.println(F("]"));
 }
 
+/**
+ * @brief Print a non-negative hundredths count as a two-decimal number
+ */
+static void print_hundredths(Print& out, uint32_t hundredths) {
+  out.print(hundredths / 100);
+  out.print('.');
+  uint8_t frac = hundredths % 100;
+  if (frac < 10) {
+    out.print('0');
+  }
+  out.print(frac);
+}
+
+/**
+ * @brief Print a fixed-point value with two decimals, no float formatting
+ */
+template<uint8_t FRAC>
+static void print_fixed(Print& out, Fixed<FRAC> value) {
+  int32_t raw = value.raw();
+  if (raw < 0) {
+    out.print('-');
+    raw = -raw;
+  }
+  
+  // Round to hundredths
+  print_hundredths(out, ((uint32_t)raw * 100 + (Fixed<FRAC>::ONE / 2)) >> FRAC);
+}
+
+/**
+ * @brief part/total as a percentage in hundredths, without 32-bit overflow
+ */
+static uint16_t percent_hundredths(uint32_t part, uint32_t total) {
+  // Scale both down together until part * 10000 fits; the ratio keeps
+  // all of total's precision instead of truncating total / 10000
+  while (part > UINT32_MAX / 10000) {
+    part >>= 1;
+    total >>= 1;
+  }
+  if (total == 0) {
+    return 0;
+  }
+  return (uint16_t)((part * 10000) / total);
+}
+
 void telemetry_print_servos(const ServoCommand_t* cmd) {
   Serial.print(F("Position: Az="));
-  Serial.print(cmd->azimuth);
+  print_hundredths(Serial, cmd->azimuth_cdeg);
   Serial.print(F("° El="));
-  Serial.print(cmd->elevation);
+  print_hundredths(Serial, cmd->elevation_cdeg);
   Serial.println(F("°"));
 }
 
@@ -92,72 +153,489 @@ void telemetry_update_heartbeat() {
   digitalWrite(LED_HEARTBEAT_PIN, g_led_state);
 }
 
+// ---------------------------------------------------------------------------
+// Frame staging
+//
+// A frame is captured once in telemetry_send() and drained by
+// telemetry_drain() no faster than Serial.availableForWrite() allows, so the
+// caller never waits on the 64-byte UART ring. Frames are staged in
+// console_stage(), which the recorder and journal dumps also use while
+// telemetry pauses for them. Binary frames are staged whole; a JSON line
+// (up to ~590 characters) is formatted one section at a time into the same
+// buffer as the previous section finishes draining.
+// Counters and timing in later sections are read as they are staged, a few
+// milliseconds after the sensor/sun/servo values captured at send time.
+// ---------------------------------------------------------------------------
+
+static_assert(SERIAL_STAGING_SIZE >= TELEM_MAX_FRAME, "staging buffer must hold a binary frame");
+
+// A binary frame is assembled this far into the staging buffer and encoded in
+// place to just after the leading delimiter (cobs_encode() allows the overlap)
+#define TELEM_RAW_OFFSET  (1 + COBS_MAX_ENCODED(TELEM_MAX_PAYLOAD) - TELEM_MAX_PAYLOAD)
+
+/**
+ * @brief Values captured when a frame is requested
+ */
+typedef struct {
+  SensorSnapshot_t snapshot;
+  SunPosition_t sun;
+  ServoCommand_t servo_cmd;
+  uint32_t seq;
+  uint32_t uptime_ms;
+  uint8_t groups;             // Subscription when the frame was requested
+} FrameCapture_t;
+
+typedef void (*JsonEmit_t)(Print& out, const FrameCapture_t* frame);
+
+/**
+ * @brief One JSON section and the subscription bit that enables it
+ */
+typedef struct {
+  uint8_t group;             // TELEM_GROUP_* bit, 0 = always emitted
+  JsonEmit_t emit;
+} JsonSection_t;
+
+static FrameCapture_t g_capture;
+static uint8_t g_next_section;        // Next JSON section to stage
+static bool g_busy = false;           // Frame staged and not fully drained
+static uint16_t g_skipped = 0;        // Frames not started, previous still draining
+static uint8_t g_groups = TELEM_GROUP_ALL;
+static uint8_t g_task_index = 0xFF;   // Telemetry task, once telemetry_start() ran
+
 /**
- * @brief Print complete system state as JSON
+ * @brief JSON: metadata (opens the object)
  */
-void telemetry_print_json(const SensorReading_t* sensor_data, 
-                          const ServoCommand_t* servo_cmd) {
-  const SunPosition_t* sun_pos = sensor_get_position();
-  SystemMode_t mode = safety_get_mode();
+static void json_meta(Print& out, const FrameCapture_t* frame) {
+  out.print(F("{\"seq\":"));
+  out.print(frame->seq);
+  out.print(F(",\"uptime\":"));
+  out.print(frame->uptime_ms / 1000);
+  out.print(F(",\"mode\":\""));
+  switch (safety_get_mode()) {
+    case MODE_NORMAL: out.print(F("NORMAL")); break;
+    case MODE_DEGRADED_1: out.print(F("DEGRADED_1")); break;
+    case MODE_DEGRADED_2: out.print(F("DEGRADED_2")); break;
+    case MODE_SAFE: out.print(F("SAFE")); break;
+    case MODE_EMERGENCY: out.print(F("EMERGENCY")); break;
+  }
+  out.print(F("\""));
+}
+
+/**
+ * @brief JSON: sensor readings, scaled back to 10 bits
+ */
+static void json_sensors(Print& out, const FrameCapture_t* frame) {
+  const SensorReading_t* sensor_data = &frame->snapshot.reading;
+  uint8_t extra_bits = sensor_data->resolution_bits - SENSOR_ADC_BITS;
   
-  Serial.print(F("{"));
+  out.print(F(",\"sensors\":{"));
+  out.print(F("\"tl\":"));
+  out.print(sensor_data->top_left >> extra_bits);
+  out.print(F(",\"tr\":"));
+  out.print(sensor_data->top_right >> extra_bits);
+  out.print(F(",\"bl\":"));
+  out.print(sensor_data->bottom_left >> extra_bits);
+  out.print(F(",\"br\":"));
+  out.print(sensor_data->bottom_right >> extra_bits);
+  out.print(F(",\"valid\":"));
+  out.print(sensor_data->valid ? F("true") : F("false"));
+  out.print(F(",\"bits\":"));
+  out.print(sensor_data->resolution_bits);
+  out.print(F(",\"gen\":"));
+  out.print(frame->snapshot.generation);
+  out.print(F("}"));
+}
+
+/**
+ * @brief JSON: sun position error
+ */
+static void json_sun(Print& out, const FrameCapture_t* frame) {
+  out.print(F(",\"sun\":{"));
+  out.print(F("\"detected\":"));
+  out.print(frame->sun.sun_detected ? F("true") : F("false"));
+  out.print(F(",\"az_error\":"));
+  print_fixed(out, frame->sun.azimuth_error);
+  out.print(F(",\"el_error\":"));
+  print_fixed(out, frame->sun.elevation_error);
+  out.print(F("}"));
+}
+
+/**
+ * @brief JSON: servo command
+ */
+static void json_servos(Print& out, const FrameCapture_t* frame) {
+  out.print(F(",\"servos\":{"));
+  out.print(F("\"az\":"));
+  print_hundredths(out, frame->servo_cmd.azimuth_cdeg);
+  out.print(F(",\"el\":"));
+  print_hundredths(out, frame->servo_cmd.elevation_cdeg);
+  out.print(F(",\"moving\":"));
+  out.print(servo_at_target() ? F("false") : F("true"));
+  out.print(F("}"));
+}
+
+/**
+ * @brief JSON: servo power (attached mask, duty %, estimated mAh)
+ */
+static void json_power(Print& out, const FrameCapture_t* frame) {
+  (void)frame;
+  ServoPowerStats_t power;
+  servo_get_power_stats(&power);
+  out.print(F(",\"power\":{\"attached\":"));
+  out.print(power.attached_mask);
+  out.print(F(",\"duty\":["));
+  for (uint8_t axis = 0; axis < SERVO_AXIS_COUNT; axis++) {
+    if (axis > 0) {
+      out.print(',');
+    }
+    print_hundredths(out, percent_hundredths(power.attached_ms[axis], power.elapsed_ms));
+  }
+  out.print(F("],\"mah\":"));
+  print_hundredths(out, power.charge_mas / 36);
+  out.print(F("}"));
+}
+
+/**
+ * @brief JSON: control cycle timing (us), opens the timing object
+ */
+static void json_timing(Print& out, const FrameCapture_t* frame) {
+  (void)frame;
+  const ControlTiming_t* timing = control_timer_get_stats();
+  uint32_t cycles = timing->cycles ? timing->cycles : 1;
+  out.print(F(",\"timing\":{\"hz\":"));
+  out.print(CONTROL_LOOP_RATE_HZ);
+  out.print(F(",\"cycles\":"));
+  out.print(timing->cycles);
+  out.print(F(",\"lat\":["));
+  out.print(timing->cycles ? timing->latency_min_us : 0);
+  out.print(',');
+  out.print(timing->latency_max_us);
+  out.print(',');
+  out.print(timing->latency_sum_us / cycles);
+  out.print(F("],\"exec\":["));
+  out.print(timing->cycles ? timing->exec_min_us : 0);
+  out.print(',');
+  out.print(timing->exec_max_us);
+  out.print(',');
+  out.print(timing->exec_sum_us / cycles);
+  out.print(F("]"));
+}
+
+/**
+ * @brief JSON: release latency histogram and idle sleep share, closes the
+ *        timing object
+ */
+static void json_timing_hist(Print& out, const FrameCapture_t* frame) {
+  (void)frame;
+  const ControlTiming_t* timing = control_timer_get_stats();
+  out.print(F(",\"hist\":["));
+  for (uint8_t i = 0; i < CONTROL_JITTER_BUCKETS; i++) {
+    if (i > 0) {
+      out.print(',');
+    }
+    out.print(timing->histogram[i]);
+  }
+  out.print(F("]"));
   
-  // Metadata
-  Serial.print(F("\"seq\":"));
-  Serial.print(g_telemetry_counter++);
-  Serial.print(F(",\"uptime\":"));
-  Serial.print(millis() / 1000);
-  Serial.print(F(",\"mode\":\""));
-  switch (mode) {
-    case MODE_NORMAL: Serial.print(F("NORMAL")); break;
-    case MODE_DEGRADED_1: Serial.print(F("DEGRADED_1")); break;
-    case MODE_DEGRADED_2: Serial.print(F("DEGRADED_2")); break;
-    case MODE_SAFE: Serial.print(F("SAFE")); break;
-    case MODE_EMERGENCY: Serial.print(F("EMERGENCY")); break;
-  }
-  Serial.print(F("\""));
-  
-  // Sensors
-  Serial.print(F(",\"sensors\":{"));
-  Serial.print(F("\"tl\":"));
-  Serial.print(sensor_data->top_left);
-  Serial.print(F(",\"tr\":"));
-  Serial.print(sensor_data->top_right);
-  Serial.print(F(",\"bl\":"));
-  Serial.print(sensor_data->bottom_left);
-  Serial.print(F(",\"br\":"));
-  Serial.print(sensor_data->bottom_right);
-  Serial.print(F(",\"valid\":"));
-  Serial.print(sensor_data->valid ? F("true") : F("false"));
-  Serial.print(F("}"));
-  
-  // Sun position
-  Serial.print(F(",\"sun\":{"));
-  Serial.print(F("\"detected\":"));
-  Serial.print(sun_pos->sun_detected ? F("true") : F("false"));
-  Serial.print(F(",\"az_error\":"));
-  Serial.print(sun_pos->azimuth_error);
-  Serial.print(F(",\"el_error\":"));
-  Serial.print(sun_pos->elevation_error);
-  Serial.print(F("}"));
-  
-  // Servos
-  Serial.print(F(",\"servos\":{"));
-  Serial.print(F("\"az\":"));
-  Serial.print(servo_cmd->azimuth);
-  Serial.print(F(",\"el\":"));
-  Serial.print(servo_cmd->elevation);
-  Serial.print(F("}"));
-  
-  // Errors
-  Serial.print(F(",\"errors\":{"));
-  Serial.print(F("\"total\":"));
-  Serial.print(safety_get_total_errors());
-  Serial.print(F(",\"sensor\":"));
-  Serial.print(sensor_get_error_count());
-  Serial.print(F(",\"servo\":"));
-  Serial.print(servo_get_error_count());
-  Serial.print(F("}"));
-  
-  Serial.println(F("}"));
+  // MCU current proxy: share of time spent in idle sleep (%)
+  uint32_t sleep_ms, elapsed_ms;
+  scheduler_get_sleep_stats(&sleep_ms, &elapsed_ms);
+  out.print(F(",\"sleep\":"));
+  print_hundredths(out, percent_hundredths(sleep_ms, elapsed_ms));
+  out.print(F("}"));
+}
+
+/**
+ * @brief JSON: error counters
+ */
+static void json_errors(Print& out, const FrameCapture_t* frame) {
+  (void)frame;
+  out.print(F(",\"errors\":{"));
+  out.print(F("\"total\":"));
+  out.print(safety_get_total_errors());
+  out.print(F(",\"sensor\":"));
+  out.print(sensor_get_error_count());
+  out.print(F(",\"servo\":"));
+  out.print(servo_get_error_count());
+  out.print(F(",\"tx_skip\":"));
+  out.print(g_skipped);
+  out.print(F("}"));
+}
+
+/**
+ * @brief JSON: per-channel sensor health verdicts
+ */
+static void json_health(Print& out, const FrameCapture_t* frame) {
+  out.print(F(",\"health\":{\"channels\":["));
+  for (uint8_t ch = 0; ch < SENSOR_CH_COUNT; ch++) {
+    if (ch > 0) out.print(',');
+    out.print((uint8_t)sensor_get_channel_health(ch));
+  }
+  out.print(F("],\"healthy_mask\":"));
+  out.print(frame->snapshot.reading.healthy_mask);
+  out.print(F("}"));
+}
+
+/**
+ * @brief JSON: close the object and the line
+ */
+static void json_close(Print& out, const FrameCapture_t* frame) {
+  (void)frame;
+  out.println(F("}"));
+}
+
+// Emitted in protocol.h group order; each section must fit
+// SERIAL_STAGING_SIZE at its widest values
+static const JsonSection_t k_json_sections[] PROGMEM = {
+  { 0,                   json_meta },
+  { TELEM_GROUP_SENSORS, json_sensors },
+  { TELEM_GROUP_SUN,     json_sun },
+  { TELEM_GROUP_SERVOS,  json_servos },
+  { TELEM_GROUP_POWER,   json_power },
+  { TELEM_GROUP_TIMING,  json_timing },
+  { TELEM_GROUP_TIMING,  json_timing_hist },
+  { TELEM_GROUP_ERRORS,  json_errors },
+  { TELEM_GROUP_HEALTH,  json_health },
+  { 0,                   json_close },
+};
+
+#define JSON_SECTION_COUNT  (sizeof(k_json_sections) / sizeof(k_json_sections[0]))
+
+/**
+ * @brief Copy one section into the raw frame
+ * @return Offset after the section
+ */
+static size_t frame_append(size_t offset, const void* section, size_t size) {
+  memcpy(&console_stage().data[TELEM_RAW_OFFSET + offset], section, size);
+  return offset + size;
+}
+
+/**
+ * @brief Build one binary frame (protocol.h) with the subscribed groups and
+ *        COBS-encode it into the staging buffer
+ */
+static void stage_binary(const FrameCapture_t* frame) {
+  const SensorReading_t* sensor_data = &frame->snapshot.reading;
+  uint8_t groups = frame->groups;
+  size_t length = 0;
+  
+  TelemHeader_t header;
+  header.type = TELEM_FRAME_TYPE;
+  header.version = TELEM_PROTOCOL_VERSION;
+  header.seq = (uint16_t)frame->seq;
+  header.uptime_ms = frame->uptime_ms;
+  header.mode = (uint8_t)safety_get_mode();
+  header.groups = groups;
+  length = frame_append(length, &header, sizeof(header));
+  
+  if (groups & TELEM_GROUP_SENSORS) {
+    TelemSensors_t sensors;
+    sensors.ldr[SENSOR_CH_TOPLEFT] = sensor_data->top_left;
+    sensors.ldr[SENSOR_CH_TOPRIGHT] = sensor_data->top_right;
+    sensors.ldr[SENSOR_CH_BOTTOMLEFT] = sensor_data->bottom_left;
+    sensors.ldr[SENSOR_CH_BOTTOMRIGHT] = sensor_data->bottom_right;
+    sensors.resolution_bits = sensor_data->resolution_bits;
+    sensors.valid = sensor_data->valid;
+    sensors.generation = frame->snapshot.generation;
+    length = frame_append(length, &sensors, sizeof(sensors));
+  }
+  
+  if (groups & TELEM_GROUP_SUN) {
+    TelemSun_t sun;
+    sun.azimuth_error = frame->sun.azimuth_error.raw();
+    sun.elevation_error = frame->sun.elevation_error.raw();
+    sun.detected = frame->sun.sun_detected;
+    length = frame_append(length, &sun, sizeof(sun));
+  }
+  
+  if (groups & TELEM_GROUP_SERVOS) {
+    TelemServos_t servos;
+    servos.azimuth_cdeg = frame->servo_cmd.azimuth_cdeg;
+    servos.elevation_cdeg = frame->servo_cmd.elevation_cdeg;
+    servos.moving = !servo_at_target();
+    length = frame_append(length, &servos, sizeof(servos));
+  }
+  
+  if (groups & TELEM_GROUP_POWER) {
+    ServoPowerStats_t power_stats;
+    servo_get_power_stats(&power_stats);
+    TelemPower_t power;
+    power.attached_mask = power_stats.attached_mask;
+    for (uint8_t axis = 0; axis < SERVO_AXIS_COUNT; axis++) {
+      power.duty_hundredths[axis] = percent_hundredths(power_stats.attached_ms[axis],
+                                                       power_stats.elapsed_ms);
+    }
+    power.charge_mas = power_stats.charge_mas;
+    length = frame_append(length, &power, sizeof(power));
+  }
+  
+  if (groups & TELEM_GROUP_TIMING) {
+    const ControlTiming_t* timing_stats = control_timer_get_stats();
+    uint32_t cycles = timing_stats->cycles ? timing_stats->cycles : 1;
+    uint32_t sleep_ms, elapsed_ms;
+    scheduler_get_sleep_stats(&sleep_ms, &elapsed_ms);
+    TelemTiming_t timing;
+    timing.rate_hz = CONTROL_LOOP_RATE_HZ;
+    timing.cycles = timing_stats->cycles;
+    timing.latency_us[0] = timing_stats->cycles ? timing_stats->latency_min_us : 0;
+    timing.latency_us[1] = timing_stats->latency_max_us;
+    timing.latency_us[2] = (uint16_t)(timing_stats->latency_sum_us / cycles);
+    timing.exec_us[0] = timing_stats->cycles ? timing_stats->exec_min_us : 0;
+    timing.exec_us[1] = timing_stats->exec_max_us;
+    timing.exec_us[2] = (uint16_t)(timing_stats->exec_sum_us / cycles);
+    memcpy(timing.histogram, timing_stats->histogram, sizeof(timing.histogram));
+    timing.sleep_hundredths = percent_hundredths(sleep_ms, elapsed_ms);
+    length = frame_append(length, &timing, sizeof(timing));
+  }
+  
+  if (groups & TELEM_GROUP_ERRORS) {
+    TelemErrors_t errors;
+    errors.total = safety_get_total_errors();
+    errors.sensor = sensor_get_error_count();
+    errors.servo = servo_get_error_count();
+    errors.telemetry_skipped = g_skipped;
+    length = frame_append(length, &errors, sizeof(errors));
+  }
+  
+  if (groups & TELEM_GROUP_HEALTH) {
+    TelemHealth_t health;
+    for (uint8_t ch = 0; ch < SENSOR_CH_COUNT; ch++) {
+      health.channel_health[ch] = (uint8_t)sensor_get_channel_health(ch);
+    }
+    health.healthy_mask = sensor_data->healthy_mask;
+    length = frame_append(length, &health, sizeof(health));
+  }
+  
+  SerialStage_t& stage = console_stage();
+  const uint8_t* raw = &stage.data[TELEM_RAW_OFFSET];
+  uint16_t crc = crc16(raw, length);
+  length = frame_append(length, &crc, sizeof(crc));
+  
+  // Delimiters on both sides so text log lines never merge into a frame
+  stage.clear();
+  stage.data[0] = TELEM_FRAME_DELIMITER;
+  stage.length = 1 + cobs_encode(raw, length, &stage.data[1]);
+  stage.data[stage.length++] = TELEM_FRAME_DELIMITER;
+}
+
+bool telemetry_send(const SensorSnapshot_t* snapshot,
+                    const ServoCommand_t* servo_cmd) {
+  if (g_busy) {
+    // Never interleave frames: drop this one and say so in the next
+    g_skipped++;
+    return false;
+  }
+  
+  g_capture.snapshot = *snapshot;
+  g_capture.sun = *sensor_get_position();
+  g_capture.servo_cmd = *servo_cmd;
+  g_capture.seq = g_telemetry_counter++;
+  g_capture.uptime_ms = millis();
+  g_capture.groups = g_groups;
+  
+  if (g_format == TELEMETRY_FORMAT_BINARY) {
+    stage_binary(&g_capture);
+    g_next_section = JSON_SECTION_COUNT;
+  } else {
+    console_stage().clear();
+    g_next_section = 0;
+  }
+  g_busy = true;
+  
+  // Start the frame now with whatever the UART ring can take
+  telemetry_drain();
+  return true;
+}
+
+void telemetry_drain() {
+  SerialStage_t& stage = console_stage();
+  while (g_busy) {
+    if (stage.empty()) {
+      if (g_next_section >= JSON_SECTION_COUNT) {
+        g_busy = false;
+        break;
+      }
+      
+      const JsonSection_t* section = &k_json_sections[g_next_section++];
+      uint8_t group = pgm_read_byte(&section->group);
+      if (group != 0 && !(g_capture.groups & group)) {
+        continue;
+      }
+      
+      JsonEmit_t emit = (JsonEmit_t)pgm_read_ptr(&section->emit);
+      stage.clear();
+      emit(stage, &g_capture);
+      if (stage.overflow) {
+        // Part of the line is already out: end it so the next frame starts
+        // clean, and let the host reject the truncated line
+        stage.clear();
+        stage.println();
+        g_next_section = JSON_SECTION_COUNT;
+      }
+      continue;
+    }
+    
+    if (!stage.drain(Serial)) {
+      break;
+    }
+  }
+}
+
+bool telemetry_is_busy() {
+  return g_busy;
+}
+
+uint16_t telemetry_get_skipped() {
+  return g_skipped;
+}
+
+void telemetry_start(uint8_t task_index) {
+  const Config_t* cfg = config_get();
+  g_task_index = task_index;
+  g_groups = cfg->telemetry_groups & TELEM_GROUP_ALL;
+  
+  uint16_t period_ms = cfg->telemetry_period_ms;
+  if (period_ms < TELEMETRY_MIN_PERIOD_MS || period_ms > TELEMETRY_MAX_PERIOD_MS) {
+    period_ms = TELEMETRY_DEFAULT_PERIOD_MS;
+  }
+  scheduler_set_period(g_task_index, period_ms);
+}
+
+bool telemetry_set_period(uint16_t period_ms) {
+  if (period_ms < TELEMETRY_MIN_PERIOD_MS || period_ms > TELEMETRY_MAX_PERIOD_MS) {
+    return false;
+  }
+  
+  scheduler_set_period(g_task_index, period_ms);
+  
+  Config_t* cfg = config_get_mutable();
+  cfg->telemetry_period_ms = period_ms;
+  config_mark_dirty();
+  
+  return true;
+}
+
+uint16_t telemetry_get_period() {
+  uint16_t period_ms = scheduler_get_period(g_task_index);
+  return period_ms ? period_ms : TELEMETRY_DEFAULT_PERIOD_MS;
+}
+
+void telemetry_set_groups(uint8_t groups) {
+  g_groups = groups & TELEM_GROUP_ALL;
+  
+  Config_t* cfg = config_get_mutable();
+  cfg->telemetry_groups = g_groups;
+  config_mark_dirty();
+}
+
+uint8_t telemetry_get_groups() {
+  return g_groups;
+}
+
+void telemetry_set_format(TelemetryFormat_t format) {
+  g_format = format;
+}
+
+TelemetryFormat_t telemetry_get_format() {
+  return g_format;
 }
\ No newline at end of file
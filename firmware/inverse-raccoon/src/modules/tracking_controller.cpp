@@ -1,44 +1,118 @@
 /**
  * @file tracking_controller.cpp
- * @brief Proportional tracking controller implementation
+ * @brief PID tracking controller implementation
+ *
+ * Each axis integrates the position increment from pid_update() (see
+ * utils/pid.h) every cycle.
+ *
+ * While the servo driver is still profiling a move on an axis, the sensor
+ * error reflects that transient rather than the sun, so the axis holds its
+ * command and state until the servo arrives.
  */
 
 #include "modules/tracking_controller.h"
+#include "modules/ephemeris.h"
+#include "modules/servo_driver.h"
 #include "config.h"
 #include "utils/crc.h"
 #include "utils/tmr.h"
+#include "utils/pid.h"
 #include <Arduino.h>
 
+// Fixed-point constants (folded at compile time)
+static const Angle_t k_default_azimuth = Angle_t::from_int(DEFAULT_AZIMUTH_DEG);
+static const Angle_t k_default_elevation = Angle_t::from_int(DEFAULT_ELEVATION_DEG);
+static const Angle_t k_min_azimuth = Angle_t::from_int(MIN_AZIMUTH_DEG);
+static const Angle_t k_max_azimuth = Angle_t::from_int(MAX_AZIMUTH_DEG);
+static const Angle_t k_min_elevation = Angle_t::from_int(MIN_ELEVATION_DEG);
+static const Angle_t k_max_elevation = Angle_t::from_int(MAX_ELEVATION_DEG);
+static const Angle_t k_invert_above = Angle_t::from_int(100);
+static const Angle_t k_revert_below = Angle_t::from_int(80);
+static const Angle_t k_zenith = Angle_t::from_int(90);
+static const Angle_t k_deadband = Angle_t::from_float(DEADBAND_DEGREES);
+
+static const TrackingGains_t k_default_gains = {
+  Gain_t::from_float(PROPORTIONAL_GAIN),
+  Gain_t::from_float(INTEGRAL_GAIN),
+  Gain_t::from_float(DERIVATIVE_GAIN),
+  Gain_t::from_float(FEEDFORWARD_GAIN)
+};
+
 // Module state
-static float g_current_azimuth = DEFAULT_AZIMUTH_DEG;
-static float g_current_elevation = DEFAULT_ELEVATION_DEG;
+static Angle_t g_current_azimuth = k_default_azimuth;
+static Angle_t g_current_elevation = k_default_elevation;
 static bool g_elevation_inverted = false;
+static TrackingGains_t g_gains = k_default_gains;
+static PidAxis_t g_azimuth_axis;
+static PidAxis_t g_elevation_axis;
+
+// Learned offset between closed-loop pointing and the ephemeris (mount
+// levelling / heading error), applied while tracking open-loop
+static Angle_t g_ephemeris_bias_azimuth;
+static Angle_t g_ephemeris_bias_elevation;
 
 static TMR<uint32_t> g_last_sun_detect_time;
 
+/**
+ * @brief Angle (Q6 degrees) -> rounded centidegrees for the servo command
+ */
+static uint16_t angle_to_cdeg(Angle_t angle) {
+  int32_t raw = angle.raw() < 0 ? 0 : angle.raw();
+  return (uint16_t)((raw * SERVO_CDEG_PER_DEG + Angle_t::ONE / 2) / Angle_t::ONE);
+}
+
 void tracking_controller_init() {
-  g_current_azimuth = DEFAULT_AZIMUTH_DEG;
-  g_current_elevation = DEFAULT_ELEVATION_DEG;
+  g_current_azimuth = k_default_azimuth;
+  g_current_elevation = k_default_elevation;
+  g_gains = k_default_gains;
+  pid_reset(&g_azimuth_axis);
+  pid_reset(&g_elevation_axis);
+  g_ephemeris_bias_azimuth = Angle_t();
+  g_ephemeris_bias_elevation = Angle_t();
   g_last_sun_detect_time.write(millis());
 }
 
-// Add at top with other static variables
+void tracking_set_gains(const TrackingGains_t* gains) {
+  g_gains = *gains;
+  
+  // Accumulated terms were built under the old gains
+  g_azimuth_axis.integral = 0;
+  g_elevation_axis.integral = 0;
+}
+
+const TrackingGains_t* tracking_get_gains() {
+  return &g_gains;
+}
 
 void tracking_calculate_command(const SunPosition_t* position, ServoCommand_t* cmd) {
   bool sun_lost = tracking_is_sun_lost();
   
+  SolarPosition_t solar;
+  Angle_t ephemeris_azimuth, ephemeris_elevation;
+  bool have_ephemeris = ephemeris_get_position(&solar) &&
+                        ephemeris_to_servo(&solar, &ephemeris_azimuth, &ephemeris_elevation);
+  
   if (sun_lost || !position->sun_detected) {
-    g_current_azimuth = DEFAULT_AZIMUTH_DEG;
-    g_current_elevation = DEFAULT_ELEVATION_DEG;
-    g_elevation_inverted = false;
+    if (have_ephemeris) {
+      // Open loop: follow the predicted sun so reacquisition is immediate
+      g_current_azimuth = (ephemeris_azimuth + g_ephemeris_bias_azimuth).clamp(k_min_azimuth, k_max_azimuth);
+      g_current_elevation = (ephemeris_elevation + g_ephemeris_bias_elevation).clamp(k_min_elevation, k_max_elevation);
+      g_elevation_inverted = (g_current_elevation > k_invert_above);
+    } else {
+      g_current_azimuth = k_default_azimuth;
+      g_current_elevation = k_default_elevation;
+      g_elevation_inverted = false;
+    }
+    pid_reset(&g_azimuth_axis);
+    pid_reset(&g_elevation_axis);
   } else {
-    float azimuth_error = position->azimuth_error;
-    float elevation_error = position->elevation_error;
+    Angle_t azimuth_error = position->azimuth_error;
+    Angle_t elevation_error = position->elevation_error;
     
 
-    if (g_current_elevation > 100.0f) {
+    if (g_current_elevation > k_invert_above) {
       g_elevation_inverted = true;
-    } else if (g_current_elevation < 80.0f) {
+    } else if (g_current_elevation < k_revert_below) {
       g_elevation_inverted = false;
     }
     
@@ -47,22 +121,39 @@ void tracking_calculate_command(const SunPosition_t* position, ServoCommand_t* c
     }
     
     // Apply azimuth control
-    if (abs(azimuth_error) > DEADBAND_DEGREES) {
-      float correction = azimuth_error * PROPORTIONAL_GAIN;
-      g_current_azimuth += correction;
-      g_current_azimuth = constrain(g_current_azimuth, MIN_AZIMUTH_DEG, MAX_AZIMUTH_DEG);
+    if (servo_is_in_motion(SERVO_AXIS_AZIMUTH)) {
+      pid_hold(&g_azimuth_axis, azimuth_error);
+    } else {
+      g_current_azimuth += pid_update(&g_azimuth_axis, &g_gains, azimuth_error, g_current_azimuth,
+                                      k_min_azimuth, k_max_azimuth);
+      g_current_azimuth = g_current_azimuth.clamp(k_min_azimuth, k_max_azimuth);
     }
     
     // Apply elevation control  
-    if (abs(elevation_error) > DEADBAND_DEGREES) {
-      float correction = elevation_error * PROPORTIONAL_GAIN;
-      g_current_elevation += correction;
-      g_current_elevation = constrain(g_current_elevation, MIN_ELEVATION_DEG, MAX_ELEVATION_DEG);
+    if (servo_is_in_motion(SERVO_AXIS_ELEVATION)) {
+      pid_hold(&g_elevation_axis, elevation_error);
+    } else {
+      g_current_elevation += pid_update(&g_elevation_axis, &g_gains, elevation_error, g_current_elevation,
+                                        k_min_elevation, k_max_elevation);
+      g_current_elevation = g_current_elevation.clamp(k_min_elevation, k_max_elevation);
+    }
+    
+    // Learn mount bias only while locked on: both sensor errors inside the
+    // deadband (not mid pull-in), and the tracker in the same elevation
+    // flip as the ephemeris solution, else the azimuths differ by ~180 deg
+    bool locked = position->azimuth_error.magnitude() <= k_deadband &&
+                  position->elevation_error.magnitude() <= k_deadband;
+    bool same_pose = (ephemeris_elevation > k_zenith) == g_elevation_inverted;
+    if (have_ephemeris && locked && same_pose && servo_at_target()) {
+      g_ephemeris_bias_azimuth += (g_current_azimuth - ephemeris_azimuth - g_ephemeris_bias_azimuth) /
+                                  (1 << EPHEMERIS_BIAS_SHIFT);
+      g_ephemeris_bias_elevation += (g_current_elevation - ephemeris_elevation - g_ephemeris_bias_elevation) /
+                                    (1 << EPHEMERIS_BIAS_SHIFT);
     }
   }
   
-  cmd->azimuth = (uint16_t)g_current_azimuth;
-  cmd->elevation = (uint16_t)g_current_elevation;
+  cmd->azimuth_cdeg = angle_to_cdeg(g_current_azimuth);
+  cmd->elevation_cdeg = angle_to_cdeg(g_current_elevation);
   cmd->crc16 = crc16(cmd, offsetof(ServoCommand_t, crc16));
 }
 
@@ -0,0 +1,171 @@
+/**
+ * @file trajectory.cpp
+ * @brief Waypoint queue and trajectory executor implementation
+ */
+
+#include "modules/trajectory.h"
+#include "config.h"
+#include <Arduino.h>
+
+// Module state
+static Waypoint_t g_queue[TRAJECTORY_QUEUE_DEPTH];
+static uint8_t g_head = 0;
+static uint8_t g_count = 0;
+static Waypoint_t g_from;               // Segment start (last point passed)
+static uint32_t g_tail_time = 0;        // Time of the newest point, if g_have_tail
+static bool g_have_tail = false;
+static uint32_t g_start_ms = 0;
+static TrajectoryState_t g_state = TRAJ_IDLE;
+static bool g_armed = false;            // Started; clock begins next tick
+static bool g_closed = false;
+static uint16_t g_underruns = 0;
+static uint16_t g_overruns = 0;
+
+static const char k_state_idle[] PROGMEM = "IDLE";
+static const char k_state_running[] PROGMEM = "RUNNING";
+static const char k_state_starved[] PROGMEM = "STARVED";
+static const char k_state_finished[] PROGMEM = "FINISHED";
+
+// Indexed by TrajectoryState_t
+static const char* const k_state_names[] PROGMEM = {
+  k_state_idle,
+  k_state_running,
+  k_state_starved,
+  k_state_finished
+};
+
+/**
+ * @brief Linear interpolation of one axis
+ *
+ * Long segments are scaled down so delta * elapsed stays inside 32 bits.
+ */
+static uint16_t interpolate(uint16_t from, uint16_t to, uint32_t elapsed, uint32_t span) {
+  while (span > 0xFFFF) {
+    span >>= 1;
+    elapsed >>= 1;
+  }
+  int32_t delta = (int32_t)to - (int32_t)from;
+  return (uint16_t)(from + (delta * (int32_t)elapsed) / (int32_t)span);
+}
+
+void trajectory_clear() {
+  g_head = 0;
+  g_count = 0;
+  g_have_tail = false;
+  g_state = TRAJ_IDLE;
+  g_armed = false;
+  g_closed = false;
+}
+
+TrajectoryAdd_t trajectory_add(const Waypoint_t* point) {
+  if (g_closed) {
+    return TRAJ_ADD_CLOSED;
+  }
+  if (point->azimuth_cdeg < MIN_AZIMUTH_DEG * SERVO_CDEG_PER_DEG ||
+      point->azimuth_cdeg > MAX_AZIMUTH_DEG * SERVO_CDEG_PER_DEG ||
+      point->elevation_cdeg < MIN_ELEVATION_DEG * SERVO_CDEG_PER_DEG ||
+      point->elevation_cdeg > MAX_ELEVATION_DEG * SERVO_CDEG_PER_DEG) {
+    return TRAJ_ADD_RANGE;
+  }
+  if (g_have_tail && point->time_ms <= g_tail_time) {
+    return TRAJ_ADD_ORDER;
+  }
+  if (g_count >= TRAJECTORY_QUEUE_DEPTH) {
+    g_overruns++;
+    return TRAJ_ADD_FULL;
+  }
+  
+  g_queue[(g_head + g_count) % TRAJECTORY_QUEUE_DEPTH] = *point;
+  g_count++;
+  g_tail_time = point->time_ms;
+  g_have_tail = true;
+  return TRAJ_ADD_OK;
+}
+
+bool trajectory_start() {
+  if (g_state != TRAJ_IDLE || g_armed) {
+    return false;
+  }
+  g_armed = true;
+  return true;
+}
+
+void trajectory_end() {
+  g_closed = true;
+}
+
+void trajectory_tick(uint32_t now, uint16_t* azimuth_cdeg, uint16_t* elevation_cdeg) {
+  if (g_armed) {
+    g_armed = false;
+    g_start_ms = now;
+    g_from.time_ms = 0;
+    g_from.azimuth_cdeg = *azimuth_cdeg;
+    g_from.elevation_cdeg = *elevation_cdeg;
+    g_state = TRAJ_RUNNING;
+  }
+  if (g_state == TRAJ_IDLE) {
+    return;   // Hold the current command
+  }
+  
+  uint32_t t = now - g_start_ms;
+  
+  // Points arriving after an underrun continue from where the path stalled
+  if (g_state == TRAJ_STARVED && g_count > 0) {
+    g_from.time_ms = t;
+    g_state = TRAJ_RUNNING;
+  }
+  
+  // Step past every point already due
+  while (g_count > 0 && t >= g_queue[g_head].time_ms) {
+    g_from = g_queue[g_head];
+    g_head = (g_head + 1) % TRAJECTORY_QUEUE_DEPTH;
+    g_count--;
+  }
+  
+  if (g_count == 0) {
+    if (g_closed) {
+      g_state = TRAJ_FINISHED;
+    } else if (g_state == TRAJ_RUNNING) {
+      g_state = TRAJ_STARVED;
+      g_underruns++;
+    }
+    *azimuth_cdeg = g_from.azimuth_cdeg;
+    *elevation_cdeg = g_from.elevation_cdeg;
+    return;
+  }
+  
+  const Waypoint_t* to = &g_queue[g_head];
+  uint32_t span = to->time_ms - g_from.time_ms;
+  uint32_t elapsed = t - g_from.time_ms;
+  *azimuth_cdeg = interpolate(g_from.azimuth_cdeg, to->azimuth_cdeg, elapsed, span);
+  *elevation_cdeg = interpolate(g_from.elevation_cdeg, to->elevation_cdeg, elapsed, span);
+}
+
+TrajectoryState_t trajectory_get_state() {
+  return g_state;
+}
+
+void trajectory_print_status() {
+  Serial.print(F("[WP] "));
+  if (g_armed) {
+    Serial.print(F("STARTING"));
+  } else {
+    Serial.print((const __FlashStringHelper*)pgm_read_ptr(&k_state_names[g_state]));
+  }
+  if (g_closed) {
+    Serial.print(F(" (ended)"));
+  }
+  Serial.print(F(", queued "));
+  Serial.print(g_count);
+  Serial.print(F("/"));
+  Serial.print(TRAJECTORY_QUEUE_DEPTH);
+  if (g_state != TRAJ_IDLE) {
+    Serial.print(F(", t "));
+    Serial.print(millis() - g_start_ms);
+    Serial.print(F(" ms"));
+  }
+  Serial.print(F(", underruns "));
+  Serial.print(g_underruns);
+  Serial.print(F(", overruns "));
+  Serial.println(g_overruns);
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+/**
+ * @file cobs.cpp
+ * @brief COBS encoder/decoder implementation
+ */
+
+#include "utils/cobs.h"
+
+size_t cobs_encode(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t code_index = 0;
+  size_t out = 1;
+  uint8_t code = 1;
+  
+  for (size_t i = 0; i < length; i++) {
+    if (src[i] == 0) {
+      dst[code_index] = code;
+      code_index = out++;
+      code = 1;
+    } else {
+      dst[out++] = src[i];
+      code++;
+      if (code == 0xFF) {
+        // Full 254-byte block: close it without an implied zero
+        dst[code_index] = code;
+        code_index = out++;
+        code = 1;
+      }
+    }
+  }
+  dst[code_index] = code;
+  
+  return out;
+}
+
+size_t cobs_decode(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t in = 0;
+  size_t out = 0;
+  
+  while (in < length) {
+    uint8_t code = src[in++];
+    if (code == 0 || in + code - 1 > length) {
+      return 0;
+    }
+    for (uint8_t i = 1; i < code; i++) {
+      if (src[in] == 0) {
+        return 0;
+      }
+      dst[out++] = src[in++];
+    }
+    // A short block implies a zero, except at the very end
+    if (code != 0xFF && in < length) {
+      dst[out++] = 0;
+    }
+  }
+  
+  return out;
+}
\ No newline at end of file
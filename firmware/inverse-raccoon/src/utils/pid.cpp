@@ -0,0 +1,69 @@
+/**
+ * @file pid.cpp
+ * @brief Tracking axis PID implementation
+ */
+
+#include "utils/pid.h"
+
+static const Angle_t k_deadband = Angle_t::from_float(DEADBAND_DEGREES);
+static const int32_t k_integral_limit = Angle_t::from_float(INTEGRAL_LIMIT_DEGREES).raw();
+
+void pid_reset(PidAxis_t* axis) {
+  *axis = PidAxis_t();
+}
+
+void pid_hold(PidAxis_t* axis, Angle_t error) {
+  axis->prev_error = error;
+}
+
+Angle_t pid_update(PidAxis_t* axis, const TrackingGains_t* gains, Angle_t error,
+                   Angle_t position, Angle_t lo, Angle_t hi) {
+  // Sun angle estimate and its slope over the history window
+  Angle_t sun = position + error;
+  Angle_t sun_rate;
+  if (axis->history_count == SUN_RATE_HISTORY) {
+    Angle_t oldest = axis->sun_history[axis->history_index];
+    sun_rate = (sun - oldest) / SUN_RATE_HISTORY;   // oldest is that many cycles back
+  } else if (axis->history_count > 0) {
+    Angle_t oldest = axis->sun_history[0];
+    sun_rate = (sun - oldest) / axis->history_count;
+  }
+  // Overwrites the oldest slot once full
+  axis->sun_history[axis->history_index] = sun;
+  axis->history_index = (axis->history_index + 1) % SUN_RATE_HISTORY;
+  if (axis->history_count < SUN_RATE_HISTORY) {
+    axis->history_count++;
+  }
+  
+  // Filtered derivative of the error
+  Angle_t raw_derivative = error - axis->prev_error;
+  axis->derivative += (raw_derivative - axis->derivative) / (1 << DERIVATIVE_FILTER_SHIFT);
+  axis->prev_error = error;
+  
+  // P and I act only outside the deadband
+  Angle_t active_error = (error.magnitude() > k_deadband) ? error : Angle_t();
+  
+  // The I term moves the axis every cycle, even inside the deadband, so a
+  // sum left over from a step would keep driving it past the sun. Drop it
+  // once the error changes sign; while tracking a ramp it keeps one sign.
+  if ((error.raw() < 0 && axis->integral > 0) || (error.raw() > 0 && axis->integral < 0)) {
+    axis->integral = 0;
+  }
+  
+  // Anti-windup: don't integrate into a travel limit, and clamp the sum
+  bool pushing_limit = (position >= hi && active_error > Angle_t()) ||
+                       (position <= lo && active_error < Angle_t());
+  if (!pushing_limit) {
+    axis->integral += active_error.raw();
+    if (axis->integral > k_integral_limit) {
+      axis->integral = k_integral_limit;
+    } else if (axis->integral < -k_integral_limit) {
+      axis->integral = -k_integral_limit;
+    }
+  }
+  
+  return active_error * gains->kp +
+         Angle_t::from_raw(axis->integral) * gains->ki +
+         axis->derivative * gains->kd +
+         sun_rate * gains->kff;
+}
\ No newline at end of file
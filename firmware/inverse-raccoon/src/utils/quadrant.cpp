@@ -0,0 +1,49 @@
+/**
+ * @file quadrant.cpp
+ * @brief Quadrant consistency check implementation
+ */
+
+#include "utils/quadrant.h"
+#include "utils/sample_filter.h"
+#include "config.h"
+
+bool quadrant_is_pointed(const uint16_t v[QUADRANT_COUNT], uint8_t spread_pct) {
+  uint16_t s[QUADRANT_COUNT] = { v[0], v[1], v[2], v[3] };
+  sort_network<QUADRANT_COUNT>(s);
+  
+  return (uint32_t)(s[3] - s[1]) * 100 <= (uint32_t)s[3] * spread_pct;
+}
+
+uint8_t quadrant_find_inconsistent(const uint16_t v[QUADRANT_COUNT]) {
+  uint16_t mean = (v[0] + v[1] + v[2] + v[3]) / QUADRANT_COUNT;
+  
+  // Too dark for ratios to mean anything
+  if (mean <= SUN_TRESHOLD) {
+    return QUADRANT_COUNT;
+  }
+  
+  // Off-pointed: the products legitimately disagree
+  if (!quadrant_is_pointed(v, SENSOR_POINTED_SPREAD_PCT)) {
+    return QUADRANT_COUNT;
+  }
+  
+  uint32_t diagonal_a = (uint32_t)v[QUADRANT_TOPLEFT] * v[QUADRANT_BOTTOMRIGHT];
+  uint32_t diagonal_b = (uint32_t)v[QUADRANT_TOPRIGHT] * v[QUADRANT_BOTTOMLEFT];
+  uint32_t larger = (diagonal_a > diagonal_b) ? diagonal_a : diagonal_b;
+  uint32_t mismatch = (diagonal_a > diagonal_b) ? diagonal_a - diagonal_b : diagonal_b - diagonal_a;
+  
+  if (mismatch * 100 <= larger * SENSOR_CONSISTENCY_PCT) {
+    return QUADRANT_COUNT;
+  }
+  
+  uint8_t suspect = 0;
+  uint16_t worst = 0;
+  for (uint8_t ch = 0; ch < QUADRANT_COUNT; ch++) {
+    uint16_t deviation = (v[ch] > mean) ? v[ch] - mean : mean - v[ch];
+    if (deviation > worst) {
+      worst = deviation;
+      suspect = ch;
+    }
+  }
+  return suspect;
+}
\ No newline at end of file
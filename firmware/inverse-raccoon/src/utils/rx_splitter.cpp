@@ -0,0 +1,74 @@
+/**
+ * @file rx_splitter.cpp
+ * @brief Text line / COBS frame receiver implementation
+ */
+
+#include "utils/rx_splitter.h"
+#include "protocol.h"
+
+void rx_splitter_init(RxSplitter_t* rx, char* buffer, uint8_t size,
+                      uint8_t frame_limit, uint16_t timeout_ms) {
+  rx->buffer = buffer;
+  rx->size = size;
+  rx->frame_limit = frame_limit;
+  rx->timeout_ms = timeout_ms;
+  rx->index = 0;
+  rx->length = 0;
+  rx->in_frame = false;
+  rx->overflow = false;
+  rx->last_ms = 0;
+}
+
+RxEvent_t rx_splitter_feed(RxSplitter_t* rx, char c, uint32_t now_ms) {
+  RxEvent_t event = RX_PENDING;
+  
+  // A frame arrives in one burst; a stall means its closing delimiter was lost
+  if (rx->in_frame && now_ms - rx->last_ms > rx->timeout_ms) {
+    rx->in_frame = false;
+    rx->index = 0;
+  }
+  rx->last_ms = now_ms;
+  
+  // Never part of a text line: opens or closes a binary frame
+  if (c == CMD_FRAME_DELIMITER) {
+    if (rx->in_frame && rx->overflow) {
+      event = RX_BAD_FRAME;
+      rx->in_frame = false;
+    } else if (rx->in_frame && rx->index > 0) {
+      event = RX_FRAME;
+      rx->length = rx->index;
+      rx->in_frame = false;
+    } else {
+      rx->in_frame = true;   // Also drops any partial text line
+    }
+    rx->overflow = false;
+    rx->index = 0;
+  }
+  else if (rx->in_frame) {
+    if (rx->index < rx->frame_limit) {
+      rx->buffer[rx->index++] = c;
+    } else {
+      rx->overflow = true;
+    }
+  }
+  // Handle newline (command complete)
+  else if (c == '\n' || c == '\r') {
+    if (rx->index > 0) {
+      rx->buffer[rx->index] = '\0';
+      event = RX_LINE;
+      rx->length = rx->index;
+      rx->index = 0;
+    }
+  }
+  // Add to buffer
+  else if (rx->index < rx->size - 1) {
+    rx->buffer[rx->index++] = c;
+  }
+  // Buffer overflow protection
+  else {
+    event = RX_LINE_TOO_LONG;
+    rx->index = 0;
+  }
+  
+  return event;
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+/**
+ * @file solar.cpp
+ * @brief Fixed-point solar position implementation
+ */
+
+#include "utils/solar.h"
+#include "utils/trig.h"
+
+#define SECONDS_PER_DAY   86400UL
+#define SECONDS_AT_NOON   43200L
+
+// Days from 1968-01-01 (start of a leap cycle) to 1970-01-01 and to
+// 2100-03-01. 2100 is the only century year in uint32_t Unix time and is
+// not leap; a phantom 29 February keeps every 4-year cycle 1461 days.
+#define DAYS_1968_TO_1970      731UL
+#define DAYS_1968_TO_2100_MAR  48272UL
+#define DAYS_PER_LEAP_CYCLE    1461UL
+
+/**
+ * @brief Binary angle -> Angle_t degrees (signed interpretation)
+ */
+static Angle_t bam_to_angle(int32_t bam) {
+  return Angle_t::from_raw((bam * 45) / 128);  // 360 * 64 / 65536
+}
+
+uint16_t solar_day_of_year(uint32_t unix_days, uint16_t* days_in_year) {
+  uint32_t d = unix_days + DAYS_1968_TO_1970;
+  if (d >= DAYS_1968_TO_2100_MAR) {
+    d++;
+  }
+  
+  uint16_t year = 1968 + 4 * (uint16_t)(d / DAYS_PER_LEAP_CYCLE);
+  uint16_t day = d % DAYS_PER_LEAP_CYCLE;
+  if (day >= 366) {
+    // Past the cycle's leap year: the other three are 365 days
+    day -= 366;
+    year += 1 + day / 365;
+    day %= 365;
+  }
+  
+  bool leap = (year % 4) == 0 && year != 2100;
+  if (year == 2100 && day >= 60) {
+    day--;   // Drop the phantom 29 February
+  }
+  *days_in_year = leap ? 366 : 365;
+  return day;
+}
+
+void solar_position(uint32_t unix_seconds, int16_t latitude_cdeg, int16_t longitude_cdeg,
+                    SolarPosition_t* position) {
+  // Day of year (0-based) and UTC second of day
+  uint16_t days_in_year;
+  uint16_t days = solar_day_of_year(unix_seconds / SECONDS_PER_DAY, &days_in_year);
+  int32_t second_of_day = unix_seconds % SECONDS_PER_DAY;
+  
+  // Fractional year gamma = 2pi/N * (doy - 1 + (hour - 12) / 24), as a
+  // binary angle; split so neither term overflows 32 bits
+  int32_t gamma = ((int32_t)days * 65536L) / days_in_year +
+                  (((second_of_day - SECONDS_AT_NOON) / 8) * 65536L) / (10800L * days_in_year);
+  BinaryAngle_t g1 = (BinaryAngle_t)gamma;
+  BinaryAngle_t g2 = g1 * 2;
+  BinaryAngle_t g3 = g1 * 3;
+  int32_t c1 = trig_cos(g1), s1 = trig_sin(g1);
+  int32_t c2 = trig_cos(g2), s2 = trig_sin(g2);
+  int32_t c3 = trig_cos(g3), s3 = trig_sin(g3);
+  
+  // Equation of time in seconds: NOAA coefficients * 13750.8 s, Q4
+  int32_t eqtime = 1 + ((411L * c1 - 7057L * s1 - 3216L * c2 - 8987L * s2) >> 19);
+  
+  // Declination as binary angle: NOAA coefficients * 65536 / 2pi, Q3
+  int32_t declination = 72 + ((-33370L * c1 + 5862L * s1 - 564L * c2 +
+                               76L * s2 - 225L * c3 + 124L * s3) >> 18);
+  
+  // True solar time (4 s of time per 0.01 deg longitude * 0.24) -> hour angle
+  int32_t solar_time = second_of_day + eqtime + ((int32_t)longitude_cdeg * 12) / 5;
+  BinaryAngle_t hour_angle = (BinaryAngle_t)(((solar_time - SECONDS_AT_NOON) * 512L) / 675);
+  BinaryAngle_t latitude = (BinaryAngle_t)(((int32_t)latitude_cdeg * 2048L) / 1125);
+  
+  int32_t sin_lat = trig_sin(latitude), cos_lat = trig_cos(latitude);
+  int32_t sin_dec = trig_sin((BinaryAngle_t)declination);
+  int32_t cos_dec = trig_cos((BinaryAngle_t)declination);
+  int32_t sin_ha = trig_sin(hour_angle), cos_ha = trig_cos(hour_angle);
+  
+  // Sun unit vector in local east/north/up, Q15
+  int32_t dec_ha = (cos_dec * cos_ha) >> 15;
+  int32_t east = -((cos_dec * sin_ha) >> 15);
+  int32_t north = (sin_dec * cos_lat - dec_ha * sin_lat) >> 15;
+  int32_t up = (sin_dec * sin_lat + dec_ha * cos_lat) >> 15;
+  uint16_t horizontal = trig_isqrt((uint32_t)(east * east) + (uint32_t)(north * north));
+  
+  position->azimuth = bam_to_angle(trig_atan2(east, north));
+  position->elevation = bam_to_angle((int16_t)trig_atan2(up, horizontal));
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+/**
+ * @file tokenizer.cpp
+ * @brief In-place tokenizer implementation
+ */
+
+#include "utils/tokenizer.h"
+#include <stddef.h>
+
+static bool is_separator(char c) {
+  return c == ' ' || c == ',' || c == '\t';
+}
+
+char* token_next(char** cursor) {
+  char* start = *cursor;
+  while (is_separator(*start)) {
+    start++;
+  }
+  if (*start == '\0') {
+    *cursor = start;
+    return NULL;
+  }
+  
+  char* end = start;
+  while (*end != '\0' && !is_separator(*end)) {
+    end++;
+  }
+  if (*end != '\0') {
+    *end++ = '\0';
+  }
+  *cursor = end;
+  return start;
+}
+
+char* token_rest(char** cursor) {
+  char* start = *cursor;
+  while (is_separator(*start)) {
+    start++;
+  }
+  if (*start == '\0') {
+    *cursor = start;
+    return NULL;
+  }
+  
+  char* end = start;
+  while (*end != '\0') {
+    end++;
+  }
+  *cursor = end;
+  while (is_separator(end[-1])) {
+    end--;
+  }
+  *end = '\0';
+  return start;
+}
+
+bool token_to_uint(const char* token, uint32_t* value) {
+  if (*token == '\0') {
+    return false;
+  }
+  
+  uint32_t result = 0;
+  for (; *token != '\0'; token++) {
+    uint8_t digit = (uint8_t)(*token - '0');
+    if (digit > 9 || result > (UINT32_MAX - digit) / 10) {
+      return false;
+    }
+    result = result * 10 + digit;
+  }
+  
+  *value = result;
+  return true;
+}
+
+bool token_to_int(const char* token, int32_t* value) {
+  bool negative = (*token == '-');
+  uint32_t magnitude;
+  if (!token_to_uint(negative ? token + 1 : token, &magnitude)) {
+    return false;
+  }
+  
+  // INT32_MIN has no positive counterpart
+  if (magnitude > (negative ? (uint32_t)INT32_MAX + 1 : (uint32_t)INT32_MAX)) {
+    return false;
+  }
+  *value = negative ? (int32_t)(0U - magnitude) : (int32_t)magnitude;
+  return true;
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+/**
+ * @file trig.cpp
+ * @brief Fixed-point trigonometry implementation
+ */
+
+#include "utils/trig.h"
+#ifdef ARDUINO
+#include <avr/pgmspace.h>
+#else
+// Host test build: the tables live in ordinary memory
+#define PROGMEM
+#define pgm_read_word(addr) (*(addr))
+#endif
+
+// sin() over a quarter turn, 64 segments, Q15
+static const int16_t k_sin_table[65] PROGMEM = {
+      0,   804,  1608,  2410,  3212,  4011,  4808,  5602,
+   6393,  7179,  7962,  8739,  9512, 10278, 11039, 11793,
+  12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+  18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+  23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+  27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+  30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+  32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+  32767
+};
+
+// atan(k / 32) for k = 0..32, binary angle
+static const uint16_t k_atan_table[33] PROGMEM = {
+     0,  326,  651,  975, 1297, 1617, 1933, 2246,
+  2555, 2860, 3159, 3453, 3742, 4025, 4302, 4572,
+  4836, 5094, 5344, 5589, 5826, 6058, 6282, 6500,
+  6712, 6917, 7117, 7310, 7498, 7679, 7856, 8026,
+  8192
+};
+
+/**
+ * @brief sin() for 0..quarter turn with linear interpolation
+ */
+static int16_t sin_quadrant(uint16_t angle) {
+  uint8_t index = angle >> 8;
+  uint8_t frac = angle & 0xFF;
+  
+  if (index >= 64) {
+    return (int16_t)pgm_read_word(&k_sin_table[64]);
+  }
+  
+  int16_t a = (int16_t)pgm_read_word(&k_sin_table[index]);
+  int16_t b = (int16_t)pgm_read_word(&k_sin_table[index + 1]);
+  return a + (int16_t)(((int32_t)(b - a) * frac) >> 8);
+}
+
+int16_t trig_sin(BinaryAngle_t angle) {
+  uint16_t within = angle & (BAM_QUARTER_TURN - 1);
+  
+  switch (angle >> 14) {
+    case 0:  return sin_quadrant(within);
+    case 1:  return sin_quadrant(BAM_QUARTER_TURN - within);
+    case 2:  return -sin_quadrant(within);
+    default: return -sin_quadrant(BAM_QUARTER_TURN - within);
+  }
+}
+
+int16_t trig_cos(BinaryAngle_t angle) {
+  return trig_sin(angle + BAM_QUARTER_TURN);
+}
+
+BinaryAngle_t trig_atan2(int32_t y, int32_t x) {
+  uint32_t ax = (x < 0) ? -(uint32_t)x : (uint32_t)x;
+  uint32_t ay = (y < 0) ? -(uint32_t)y : (uint32_t)y;
+  
+  if (ax == 0 && ay == 0) {
+    return 0;
+  }
+  
+  // Reduce to the first octant: ratio in [0, 1]
+  bool swapped = ay > ax;
+  uint32_t num = swapped ? ax : ay;
+  uint32_t den = swapped ? ay : ax;
+  
+  // Keep the division in 32 bits: ratio in Q13 (index 5 bits, frac 8 bits)
+  while (num > 0x3FFFF) {
+    num >>= 1;
+    den >>= 1;
+  }
+  uint16_t ratio = (uint16_t)((num << 13) / den);
+  uint8_t index = ratio >> 8;
+  uint8_t frac = ratio & 0xFF;
+  
+  uint16_t angle;
+  if (index >= 32) {
+    angle = pgm_read_word(&k_atan_table[32]);
+  } else {
+    uint16_t a = pgm_read_word(&k_atan_table[index]);
+    uint16_t b = pgm_read_word(&k_atan_table[index + 1]);
+    angle = a + (uint16_t)(((uint32_t)(b - a) * frac) >> 8);
+  }
+  
+  // Unfold octant, then quadrant
+  if (swapped) angle = BAM_QUARTER_TURN - angle;
+  if (x < 0) angle = 2 * BAM_QUARTER_TURN - angle;
+  if (y < 0) angle = (uint16_t)(0U - angle);
+  
+  return angle;
+}
+
+uint16_t trig_isqrt(uint32_t value) {
+  uint32_t result = 0;
+  uint32_t bit = 1UL << 30;
+  
+  while (bit > value) {
+    bit >>= 2;
+  }
+  
+  while (bit != 0) {
+    if (value >= result + bit) {
+      value -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  
+  return (uint16_t)result;
+}
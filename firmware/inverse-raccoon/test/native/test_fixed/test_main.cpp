@@ -0,0 +1,136 @@
+/**
+ * @file test_main.cpp
+ * @brief Host tests for Fixed<FRAC>: saturation at both rails and the
+ *        rounding rule of each conversion and operator
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include "utils/fixed.h"
+
+typedef Fixed<6> Q6;
+typedef Fixed<14> Q14;
+
+static const Q6 k_max = Q6::from_raw(INT16_MAX);
+static const Q6 k_min = Q6::from_raw(INT16_MIN);
+
+// Config constants must fold without float code on the target
+static_assert(Q6::from_float(2.0f).raw() == 128, "from_float is not constexpr");
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_from_float_rounds_half_away_from_zero(void) {
+  TEST_ASSERT_EQUAL_INT16(1, Q6::from_float(0.5f / 64).raw());
+  TEST_ASSERT_EQUAL_INT16(-1, Q6::from_float(-0.5f / 64).raw());
+  TEST_ASSERT_EQUAL_INT16(0, Q6::from_float(0.49f / 64).raw());
+  TEST_ASSERT_EQUAL_INT16(1638, Q14::from_float(0.1f).raw());
+}
+
+void test_constructors_saturate(void) {
+  TEST_ASSERT_EQUAL_INT16(INT16_MAX, Q6::from_int(600).raw());
+  TEST_ASSERT_EQUAL_INT16(INT16_MIN, Q6::from_int(-600).raw());
+  TEST_ASSERT_EQUAL_INT16(INT16_MAX, Q6::from_float(1000.0f).raw());
+  TEST_ASSERT_EQUAL_INT16(INT16_MIN, Q6::from_float(-1000.0f).raw());
+  TEST_ASSERT_EQUAL_INT16(INT16_MAX, Q6::from_raw(70000).raw());
+  TEST_ASSERT_EQUAL_INT16(INT16_MIN, Q6::from_raw(-70000).raw());
+  // Q1.14 tops out just under 2.0
+  TEST_ASSERT_EQUAL_INT16(INT16_MAX, Q14::from_int(2).raw());
+}
+
+void test_add_sub_clip_instead_of_wrapping(void) {
+  Q6 one = Q6::from_raw(1);
+  TEST_ASSERT_EQUAL_INT16(INT16_MAX, (k_max + one).raw());
+  TEST_ASSERT_EQUAL_INT16(INT16_MIN, (k_min - one).raw());
+  TEST_ASSERT_EQUAL_INT16(INT16_MAX, (k_max - k_min).raw());
+  TEST_ASSERT_EQUAL_INT16(INT16_MIN, (k_min - k_max).raw());
+  
+  Q6 acc = Q6::from_int(500);
+  acc += Q6::from_int(100);
+  TEST_ASSERT_EQUAL_INT16(INT16_MAX, acc.raw());
+  acc = Q6::from_int(-500);
+  acc -= Q6::from_int(100);
+  TEST_ASSERT_EQUAL_INT16(INT16_MIN, acc.raw());
+}
+
+void test_negate_and_magnitude_of_most_negative(void) {
+  // -INT16_MIN does not fit; both clip to the positive rail
+  TEST_ASSERT_EQUAL_INT16(INT16_MAX, (-k_min).raw());
+  TEST_ASSERT_EQUAL_INT16(INT16_MAX, k_min.magnitude().raw());
+  TEST_ASSERT_EQUAL_INT16(64, Q6::from_int(-1).magnitude().raw());
+}
+
+void test_integer_multiply_saturates(void) {
+  TEST_ASSERT_EQUAL_INT16(INT16_MAX, (Q6::from_int(300) * (int16_t)2).raw());
+  TEST_ASSERT_EQUAL_INT16(INT16_MIN, (Q6::from_int(300) * (int16_t)-2).raw());
+  TEST_ASSERT_EQUAL_INT16(-600, (Q6::from_raw(300) * (int16_t)-2).raw());
+}
+
+void test_divide_truncates_toward_zero(void) {
+  TEST_ASSERT_EQUAL_INT16(2, (Q6::from_raw(7) / 3).raw());
+  TEST_ASSERT_EQUAL_INT16(-2, (Q6::from_raw(-7) / 3).raw());
+  TEST_ASSERT_EQUAL_INT16(INT16_MAX, (k_min / -1).raw());
+}
+
+void test_gain_multiply_rounds_to_nearest(void) {
+  Q14 half = Q14::from_float(0.5f);
+  TEST_ASSERT_EQUAL_INT16(1, (Q6::from_raw(1) * Q14::from_float(0.6f)).raw());
+  TEST_ASSERT_EQUAL_INT16(0, (Q6::from_raw(1) * Q14::from_float(0.4f)).raw());
+  // Ties round up (toward +inf): 1.5 -> 2, -1.5 -> -1
+  TEST_ASSERT_EQUAL_INT16(2, (Q6::from_raw(3) * half).raw());
+  TEST_ASSERT_EQUAL_INT16(-1, (Q6::from_raw(-3) * half).raw());
+  // 20 degrees * 0.09 = 1.8 degrees, within half a Q6 step
+  TEST_ASSERT_INT16_WITHIN(1, 115, (Q6::from_int(20) * Q14::from_float(0.09f)).raw());
+}
+
+void test_gain_multiply_saturates(void) {
+  Q14 almost_two = Q14::from_raw(INT16_MAX);
+  TEST_ASSERT_EQUAL_INT16(INT16_MAX, (Q6::from_int(400) * almost_two).raw());
+  TEST_ASSERT_EQUAL_INT16(INT16_MIN, (Q6::from_int(-400) * almost_two).raw());
+}
+
+void test_product_truncates_and_saturates(void) {
+  Q14 tenth = Q14::from_float(0.1f);
+  // 15 counts * 0.1 = 1.5 degrees; 1638/16384 is slightly under 0.1 and
+  // the shift floors, so the result lands one step low
+  TEST_ASSERT_EQUAL_INT16(95, Q6::product(15, tenth).raw());
+  TEST_ASSERT_EQUAL_INT16(-96, Q6::product(-15, tenth).raw());
+  // Extra fractional bits in the integer operand (oversampled counts)
+  TEST_ASSERT_EQUAL_INT16(Q6::product(15, tenth).raw(), Q6::product(15 << 3, tenth, 3).raw());
+  TEST_ASSERT_EQUAL_INT16(INT16_MAX, Q6::product(30000, Q14::from_int(1)).raw());
+  TEST_ASSERT_EQUAL_INT16(INT16_MIN, Q6::product(-30000, Q14::from_int(1)).raw());
+}
+
+void test_to_int_truncates_toward_zero(void) {
+  TEST_ASSERT_EQUAL_INT16(1, Q6::from_float(1.9f).to_int());
+  TEST_ASSERT_EQUAL_INT16(-1, Q6::from_float(-1.9f).to_int());
+  TEST_ASSERT_EQUAL_INT16(511, k_max.to_int());
+  TEST_ASSERT_EQUAL_INT16(-512, k_min.to_int());
+}
+
+void test_clamp(void) {
+  Q6 lo = Q6::from_int(-10);
+  Q6 hi = Q6::from_int(10);
+  TEST_ASSERT_EQUAL_INT16(hi.raw(), k_max.clamp(lo, hi).raw());
+  TEST_ASSERT_EQUAL_INT16(lo.raw(), k_min.clamp(lo, hi).raw());
+  TEST_ASSERT_EQUAL_INT16(3, Q6::from_raw(3).clamp(lo, hi).raw());
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_from_float_rounds_half_away_from_zero);
+  RUN_TEST(test_constructors_saturate);
+  RUN_TEST(test_add_sub_clip_instead_of_wrapping);
+  RUN_TEST(test_negate_and_magnitude_of_most_negative);
+  RUN_TEST(test_integer_multiply_saturates);
+  RUN_TEST(test_divide_truncates_toward_zero);
+  RUN_TEST(test_gain_multiply_rounds_to_nearest);
+  RUN_TEST(test_gain_multiply_saturates);
+  RUN_TEST(test_product_truncates_and_saturates);
+  RUN_TEST(test_to_int_truncates_toward_zero);
+  RUN_TEST(test_clamp);
+  return UNITY_END();
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+/**
+ * @file test_main.cpp
+ * @brief Host tests for ADC oversampling: synthetic noisy conversions are
+ *        decimated with oversample_decimate() and checked for the
+ *        resolution they gain
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <stdint.h>
+#include "utils/sample_filter.h"
+
+#define ADC_MAX   1023
+
+// Deterministic generator so failures reproduce
+static uint32_t g_seed;
+
+static double uniform() {
+  g_seed = g_seed * 1664525UL + 1013904223UL;
+  return ((g_seed >> 8) + 0.5) / 16777216.0;
+}
+
+static double gaussian() {
+  return sqrt(-2.0 * log(uniform())) * cos(2.0 * M_PI * uniform());
+}
+
+/**
+ * @brief Ideal 10-bit conversion of an input in LSB, with gaussian noise
+ */
+static uint16_t convert(double input_lsb, double noise_lsb) {
+  long code = lround(input_lsb + noise_lsb * gaussian());
+  if (code < 0) code = 0;
+  if (code > ADC_MAX) code = ADC_MAX;
+  return (uint16_t)code;
+}
+
+/**
+ * @brief One burst of 4^k conversions, decimated, back in 10-bit LSB
+ */
+static double burst(uint8_t bits, double input_lsb, double noise_lsb) {
+  uint16_t count = (uint16_t)1 << (2 * bits);
+  uint32_t sum = 0;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += convert(input_lsb, noise_lsb);
+  }
+  
+  uint16_t decimated;
+  switch (bits) {
+    case 1:  decimated = oversample_decimate<1>(sum); break;
+    case 2:  decimated = oversample_decimate<2>(sum); break;
+    default: decimated = oversample_decimate<3>(sum); break;
+  }
+  return decimated / (double)(1 << bits);
+}
+
+/**
+ * @brief RMS error over many random inputs across the working range
+ */
+static double rms_error(uint8_t bits, double noise_lsb) {
+  const int trials = 2000;
+  double sum_sq = 0.0;
+  g_seed = 12345;
+  for (int i = 0; i < trials; i++) {
+    double input = 100.0 + 800.0 * uniform();
+    double error = (bits == 0) ? convert(input, noise_lsb) - input
+                               : burst(bits, input, noise_lsb) - input;
+    sum_sq += error * error;
+  }
+  return sqrt(sum_sq / trials);
+}
+
+void setUp(void) {
+  g_seed = 1;
+}
+
+void tearDown(void) {}
+
+void test_constant_input_scales_exactly(void) {
+  // 4^k copies of x decimate to x << k
+  TEST_ASSERT_EQUAL_UINT16(512 << 1, oversample_decimate<1>(4UL * 512));
+  TEST_ASSERT_EQUAL_UINT16(512 << 2, oversample_decimate<2>(16UL * 512));
+  TEST_ASSERT_EQUAL_UINT16(512 << 3, oversample_decimate<3>(64UL * 512));
+}
+
+void test_full_scale_fits_16_bits(void) {
+  TEST_ASSERT_EQUAL_UINT16(ADC_MAX << 3, oversample_decimate<3>(64UL * ADC_MAX));
+}
+
+void test_decimation_rounds_to_nearest(void) {
+  // Sum of 64 samples = 64 * 500 + 4 -> 4000.5 at 13 bits
+  TEST_ASSERT_EQUAL_UINT16(4001, oversample_decimate<3>(64UL * 500 + 4));
+  TEST_ASSERT_EQUAL_UINT16(4000, oversample_decimate<3>(64UL * 500 + 3));
+}
+
+void test_noise_buys_resolution(void) {
+  // 0.5 LSB of noise dithers the quantizer; each k should roughly halve the error
+  double rms[4];
+  for (uint8_t bits = 0; bits <= 3; bits++) {
+    rms[bits] = rms_error(bits, 0.5);
+  }
+  
+  for (uint8_t bits = 1; bits <= 3; bits++) {
+    TEST_ASSERT_LESS_THAN(rms[bits - 1] * 0.7, rms[bits]);
+  }
+  // k = 3 resolves an eighth of an LSB
+  TEST_ASSERT_LESS_THAN(0.125, rms[3]);
+  TEST_ASSERT_LESS_THAN(rms[0] / 4.0, rms[3]);
+}
+
+void test_decimated_reading_is_unbiased(void) {
+  double total = 0.0;
+  const int trials = 400;
+  g_seed = 777;
+  for (int i = 0; i < trials; i++) {
+    double input = 300.0 + 400.0 * uniform();
+    total += burst(3, input, 0.7) - input;
+  }
+  TEST_ASSERT_DOUBLE_WITHIN(0.02, 0.0, total / trials);
+}
+
+void test_sub_lsb_steps_resolved(void) {
+  // Eight inputs an eighth of an LSB apart come out in order at 13 bits
+  double previous = -1.0;
+  for (int step = 0; step < 8; step++) {
+    double input = 600.0 + step / 8.0;
+    double mean = 0.0;
+    for (int i = 0; i < 16; i++) {
+      mean += burst(3, input, 0.7);
+    }
+    mean /= 16;
+    TEST_ASSERT_DOUBLE_WITHIN(1.0 / 16, input, mean);
+    TEST_ASSERT_GREATER_THAN(previous, mean);
+    previous = mean;
+  }
+}
+
+void test_no_noise_no_gain(void) {
+  // Without dither every conversion agrees, so oversampling adds nothing
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, 500.0, burst(3, 500.3, 0.0));
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_constant_input_scales_exactly);
+  RUN_TEST(test_full_scale_fits_16_bits);
+  RUN_TEST(test_decimation_rounds_to_nearest);
+  RUN_TEST(test_noise_buys_resolution);
+  RUN_TEST(test_decimated_reading_is_unbiased);
+  RUN_TEST(test_sub_lsb_steps_resolved);
+  RUN_TEST(test_no_noise_no_gain);
+  return UNITY_END();
+}
\ No newline at end of file
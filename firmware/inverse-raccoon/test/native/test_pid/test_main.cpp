@@ -0,0 +1,179 @@
+/**
+ * @file test_main.cpp
+ * @brief Host step/ramp responses of the tracking PID against the old
+ *        proportional law
+ *
+ * Plant: the servo reaches each command within one cycle, and the sensors
+ * report (sun - position) quantized to Angle_t. One sample is one control
+ * cycle (CONTROL_LOOP_PERIOD_MS).
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include "utils/pid.h"
+
+#define SIM_CYCLES      600
+#define SIM_TAIL        100     // Cycles averaged for the steady-state error
+#define SIM_START_DEG   60.0
+
+typedef struct {
+  int settle_cycles;            // First cycle after which |e| stays <= deadband
+  double steady_mean;           // Mean error over the last SIM_TAIL cycles
+  double steady_max;            // Peak |error| over the last SIM_TAIL cycles
+} Response_t;
+
+static const TrackingGains_t k_pid_gains = {
+  Gain_t::from_float(PROPORTIONAL_GAIN),
+  Gain_t::from_float(INTEGRAL_GAIN),
+  Gain_t::from_float(DERIVATIVE_GAIN),
+  Gain_t::from_float(FEEDFORWARD_GAIN)
+};
+
+static const TrackingGains_t k_p_gains = {
+  Gain_t::from_float(PROPORTIONAL_GAIN), Gain_t(), Gain_t(), Gain_t()
+};
+
+static const Angle_t k_lo = Angle_t::from_int(0);
+static const Angle_t k_hi = Angle_t::from_int(180);
+
+static PidAxis_t g_axis;
+
+static Angle_t measure(double sun, Angle_t position) {
+  return Angle_t::from_raw(lround((sun - position.raw() / (double)Angle_t::ONE) * Angle_t::ONE));
+}
+
+/**
+ * @brief Run the loop against a sun at start + step + rate * cycle
+ */
+static Response_t simulate(const TrackingGains_t* gains, double step_deg, double rate_deg) {
+  Response_t r = { -1, 0.0, 0.0 };
+  Angle_t position = Angle_t::from_float(SIM_START_DEG);
+  pid_reset(&g_axis);
+  
+  for (int k = 0; k < SIM_CYCLES; k++) {
+    Angle_t error = measure(SIM_START_DEG + step_deg + rate_deg * k, position);
+    double e = error.raw() / (double)Angle_t::ONE;
+    
+    if (fabs(e) > DEADBAND_DEGREES) {
+      r.settle_cycles = -1;
+    } else if (r.settle_cycles < 0) {
+      r.settle_cycles = k;
+    }
+    if (k >= SIM_CYCLES - SIM_TAIL) {
+      r.steady_mean += e / SIM_TAIL;
+      if (fabs(e) > r.steady_max) r.steady_max = fabs(e);
+    }
+    
+    position += pid_update(&g_axis, gains, error, position, k_lo, k_hi);
+    position = position.clamp(k_lo, k_hi);
+  }
+  return r;
+}
+
+static void report(const char* name, Response_t r) {
+  printf("  %-16s settle %3d cycles  steady mean %+.3f max %.3f deg\n",
+         name, r.settle_cycles, r.steady_mean, r.steady_max);
+}
+
+void setUp(void) {
+  pid_reset(&g_axis);
+}
+
+void tearDown(void) {}
+
+void test_p_only_gains_reproduce_old_law(void) {
+  // Old controller: position += e * Kp outside the deadband, nothing inside
+  const Angle_t deadband = Angle_t::from_float(DEADBAND_DEGREES);
+  Angle_t old_position = Angle_t::from_float(SIM_START_DEG);
+  Angle_t new_position = old_position;
+  
+  for (int k = 0; k < 200; k++) {
+    double sun = SIM_START_DEG + 25.0 + 0.05 * k;
+    Angle_t old_error = measure(sun, old_position);
+    if (old_error.magnitude() > deadband) {
+      old_position += old_error * k_p_gains.kp;
+    }
+    new_position += pid_update(&g_axis, &k_p_gains, measure(sun, new_position),
+                               new_position, k_lo, k_hi);
+    TEST_ASSERT_EQUAL_INT16(old_position.raw(), new_position.raw());
+  }
+}
+
+void test_step_settles_faster_and_closer(void) {
+  Response_t p = simulate(&k_p_gains, 20.0, 0.0);
+  Response_t pid = simulate(&k_pid_gains, 20.0, 0.0);
+  report("P    20 deg step", p);
+  report("PID  20 deg step", pid);
+  
+  TEST_ASSERT_TRUE(pid.settle_cycles >= 0);
+  TEST_ASSERT_TRUE(pid.settle_cycles < p.settle_cycles);
+  // P parks just inside the deadband; the integral pulls the rest in
+  TEST_ASSERT_GREATER_THAN(1.5, fabs(p.steady_mean));
+  TEST_ASSERT_LESS_THAN(0.5, pid.steady_max);
+}
+
+void test_step_does_not_hunt(void) {
+  // The sum left from the approach must not keep pushing past the sun
+  Response_t pid = simulate(&k_pid_gains, -20.0, 0.0);
+  report("PID -20 deg step", pid);
+  TEST_ASSERT_TRUE(pid.settle_cycles >= 0);
+  TEST_ASSERT_LESS_THAN(30, pid.settle_cycles);
+}
+
+void test_ramp_lag_reduced(void) {
+  static const double rates[] = { 0.02, 0.1 };   // deg per cycle
+  for (unsigned i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+    Response_t p = simulate(&k_p_gains, 0.0, rates[i]);
+    Response_t pid = simulate(&k_pid_gains, 0.0, rates[i]);
+    printf("  ramp %.2f deg/cycle\n", rates[i]);
+    report("P", p);
+    report("PID", pid);
+    
+    // P only moves once the lag reaches the deadband, so it rides its edge
+    TEST_ASSERT_GREATER_THAN(1.8, p.steady_mean);
+    TEST_ASSERT_LESS_THAN(p.steady_mean * 0.6, pid.steady_mean);
+    TEST_ASSERT_LESS_THAN(p.steady_max, pid.steady_max);
+  }
+}
+
+void test_feedforward_matches_ramp_rate(void) {
+  // Feedforward only, axis held still: the step is Kff times the slope of
+  // the sun estimate, before and after the rate history fills
+  const TrackingGains_t ff_only = { Gain_t(), Gain_t(), Gain_t(), Gain_t::from_int(1) };
+  static const int16_t rates_raw[] = { Angle_t::ONE, Angle_t::ONE / 4, -Angle_t::ONE / 2 };
+  Angle_t position = Angle_t::from_int(90);
+  
+  for (unsigned i = 0; i < sizeof(rates_raw) / sizeof(rates_raw[0]); i++) {
+    pid_reset(&g_axis);
+    for (int k = 0; k < 4 * SUN_RATE_HISTORY; k++) {
+      Angle_t error = Angle_t::from_raw((int32_t)rates_raw[i] * k);
+      Angle_t step = pid_update(&g_axis, &ff_only, error, position, k_lo, k_hi);
+      if (k > 0) {
+        TEST_ASSERT_EQUAL_INT16(rates_raw[i], step.raw());
+      }
+    }
+  }
+}
+
+void test_integral_frozen_at_travel_limit(void) {
+  // Sun beyond the upper stop: the sum must not wind up against it
+  Angle_t position = k_hi;
+  for (int k = 0; k < 100; k++) {
+    pid_update(&g_axis, &k_pid_gains, Angle_t::from_int(10), position, k_lo, k_hi);
+  }
+  TEST_ASSERT_EQUAL_INT32(0, g_axis.integral);
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_p_only_gains_reproduce_old_law);
+  RUN_TEST(test_step_settles_faster_and_closer);
+  RUN_TEST(test_step_does_not_hunt);
+  RUN_TEST(test_ramp_lag_reduced);
+  RUN_TEST(test_feedforward_matches_ramp_rate);
+  RUN_TEST(test_integral_frozen_at_travel_limit);
+  return UNITY_END();
+}
\ No newline at end of file
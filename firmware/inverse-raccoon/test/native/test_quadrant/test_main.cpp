@@ -0,0 +1,108 @@
+/**
+ * @file test_main.cpp
+ * @brief Host tests for the quadrant consistency check
+ *
+ * The light model is a four-quadrant cell behind a cross-shaped vane. The
+ * vane shades each quadrant in proportion to how far the sun is off
+ * toward the other side, per axis, and the shadows add, so the field is
+ * not separable once the sun is off along both axes.
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include "config.h"
+#include "utils/quadrant.h"
+
+#define LIT_COUNTS      850
+#define AMBIENT_COUNTS  60
+#define SHADE_PER_DEG   0.04    // Fraction of a quadrant shaded per degree
+
+/**
+ * @brief Quadrant readings for a sun offset (positive = right / up)
+ */
+static void scene(double azimuth_deg, double elevation_deg, uint16_t v[QUADRANT_COUNT]) {
+  // Sign of each quadrant's side: +1 right/top, -1 left/bottom
+  const int8_t side_x[QUADRANT_COUNT] = { -1, +1, -1, +1 };
+  const int8_t side_y[QUADRANT_COUNT] = { +1, +1, -1, -1 };
+  
+  for (uint8_t ch = 0; ch < QUADRANT_COUNT; ch++) {
+    double shadow = 0.0;
+    double away_x = -side_x[ch] * azimuth_deg;
+    double away_y = -side_y[ch] * elevation_deg;
+    if (away_x > 0) shadow += away_x * SHADE_PER_DEG;
+    if (away_y > 0) shadow += away_y * SHADE_PER_DEG;
+    if (shadow > 1.0) shadow = 1.0;
+    v[ch] = (uint16_t)(AMBIENT_COUNTS + (LIT_COUNTS - AMBIENT_COUNTS) * (1.0 - shadow) + 0.5);
+  }
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_pointed_scene_is_consistent(void) {
+  uint16_t v[QUADRANT_COUNT];
+  scene(0.0, 0.0, v);
+  TEST_ASSERT_TRUE(quadrant_is_pointed(v, SENSOR_POINTED_SPREAD_PCT));
+  TEST_ASSERT_EQUAL_UINT8(QUADRANT_COUNT, quadrant_find_inconsistent(v));
+}
+
+void test_diagonal_off_pointing_is_not_a_fault(void) {
+  // Sun 15 degrees right and 15 up: TR lit, BL doubly shaded
+  uint16_t v[QUADRANT_COUNT];
+  scene(15.0, 15.0, v);
+  
+  // The raw cross-products disagree by more than the threshold...
+  uint32_t a = (uint32_t)v[QUADRANT_TOPLEFT] * v[QUADRANT_BOTTOMRIGHT];
+  uint32_t b = (uint32_t)v[QUADRANT_TOPRIGHT] * v[QUADRANT_BOTTOMLEFT];
+  uint32_t mismatch = (a > b) ? a - b : b - a;
+  TEST_ASSERT_GREATER_THAN((a > b ? a : b) * SENSOR_CONSISTENCY_PCT, mismatch * 100);
+  
+  // ...but off-pointing is not a sensor fault
+  TEST_ASSERT_FALSE(quadrant_is_pointed(v, SENSOR_POINTED_SPREAD_PCT));
+  TEST_ASSERT_EQUAL_UINT8(QUADRANT_COUNT, quadrant_find_inconsistent(v));
+}
+
+void test_no_false_fault_anywhere_in_the_field(void) {
+  uint16_t v[QUADRANT_COUNT];
+  for (int az = -30; az <= 30; az += 2) {
+    for (int el = -30; el <= 30; el += 2) {
+      scene(az, el, v);
+      TEST_ASSERT_EQUAL_UINT8(QUADRANT_COUNT, quadrant_find_inconsistent(v));
+    }
+  }
+}
+
+void test_dim_channel_flagged_when_pointed(void) {
+  // Pointed, but bottom-right has lost half its response
+  uint16_t v[QUADRANT_COUNT];
+  scene(1.0, -1.0, v);
+  v[QUADRANT_BOTTOMRIGHT] /= 2;
+  TEST_ASSERT_EQUAL_UINT8(QUADRANT_BOTTOMRIGHT, quadrant_find_inconsistent(v));
+}
+
+void test_lone_bright_corner_is_not_flagged(void) {
+  // Sun far off along a diagonal: three quadrants in shadow
+  uint16_t v[QUADRANT_COUNT];
+  scene(-30.0, -30.0, v);
+  TEST_ASSERT_EQUAL_UINT16(LIT_COUNTS, v[QUADRANT_BOTTOMLEFT]);
+  TEST_ASSERT_EQUAL_UINT8(QUADRANT_COUNT, quadrant_find_inconsistent(v));
+}
+
+void test_dark_scene_is_not_checked(void) {
+  const uint16_t v[QUADRANT_COUNT] = { SUN_TRESHOLD, SUN_TRESHOLD, 10, SUN_TRESHOLD };
+  TEST_ASSERT_EQUAL_UINT8(QUADRANT_COUNT, quadrant_find_inconsistent(v));
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_pointed_scene_is_consistent);
+  RUN_TEST(test_diagonal_off_pointing_is_not_a_fault);
+  RUN_TEST(test_no_false_fault_anywhere_in_the_field);
+  RUN_TEST(test_dim_channel_flagged_when_pointed);
+  RUN_TEST(test_lone_bright_corner_is_not_flagged);
+  RUN_TEST(test_dark_scene_is_not_checked);
+  return UNITY_END();
+}
\ No newline at end of file
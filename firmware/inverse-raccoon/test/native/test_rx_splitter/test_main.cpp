@@ -0,0 +1,188 @@
+/**
+ * @file test_main.cpp
+ * @brief Host tests for the command receiver (text lines vs COBS frames)
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "config.h"
+#include "protocol.h"
+#include "utils/rx_splitter.h"
+#include "utils/cobs.h"
+#include "utils/crc.h"
+
+static char g_buffer[CMD_BUFFER_SIZE];
+static RxSplitter_t g_rx;
+static uint32_t g_now;
+
+// Every event produced while feeding, in order
+static RxEvent_t g_events[8];
+static uint8_t g_event_count;
+static char g_line[CMD_BUFFER_SIZE];
+static uint8_t g_frame[CMD_BUFFER_SIZE];
+static uint8_t g_frame_length;
+
+void setUp(void) {
+  rx_splitter_init(&g_rx, g_buffer, CMD_BUFFER_SIZE,
+                   CMD_MAX_ENCODED, CMD_FRAME_TIMEOUT_MS);
+  g_now = 1000;
+  g_event_count = 0;
+  g_line[0] = '\0';
+  g_frame_length = 0;
+}
+
+void tearDown(void) {}
+
+static void feed(const uint8_t* bytes, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    RxEvent_t event = rx_splitter_feed(&g_rx, (char)bytes[i], g_now);
+    if (event == RX_PENDING) {
+      continue;
+    }
+    if (g_event_count < sizeof(g_events) / sizeof(g_events[0])) {
+      g_events[g_event_count++] = event;
+    }
+    if (event == RX_LINE) {
+      strcpy(g_line, g_buffer);
+    } else if (event == RX_FRAME) {
+      memcpy(g_frame, g_buffer, g_rx.length);
+      g_frame_length = g_rx.length;
+    }
+  }
+}
+
+static void feed_text(const char* text) {
+  feed((const uint8_t*)text, strlen(text));
+}
+
+/**
+ * @brief Frame a one-command MANUAL request whose bytes include '\n' and '\r'
+ * @return Bytes written to out, delimiters included
+ */
+static size_t build_manual_request(uint8_t* out) {
+  uint8_t payload[32];
+  size_t length = 0;
+  
+  CmdHeader_t header = { CMD_FRAME_TYPE, CMD_PROTOCOL_VERSION, 0x0A0D, 1 };
+  CmdRecord_t record = { CMD_OP_MANUAL, sizeof(CmdManual_t) };
+  CmdManual_t manual = { 0x0A0D, 0x0D0A };
+  memcpy(payload + length, &header, sizeof(header));
+  length += sizeof(header);
+  memcpy(payload + length, &record, sizeof(record));
+  length += sizeof(record);
+  memcpy(payload + length, &manual, sizeof(manual));
+  length += sizeof(manual);
+  uint16_t crc = crc16(payload, length);
+  memcpy(payload + length, &crc, sizeof(crc));
+  length += sizeof(crc);
+  
+  out[0] = CMD_FRAME_DELIMITER;
+  size_t encoded = cobs_encode(payload, length, out + 1);
+  out[1 + encoded] = CMD_FRAME_DELIMITER;
+  return encoded + 2;
+}
+
+void test_frame_then_text_line(void) {
+  uint8_t request[40];
+  size_t request_length = build_manual_request(request);
+  
+  feed(request, request_length);
+  feed_text("STATUS\n");
+  
+  TEST_ASSERT_EQUAL_UINT8(2, g_event_count);
+  TEST_ASSERT_EQUAL(RX_FRAME, g_events[0]);
+  TEST_ASSERT_EQUAL(RX_LINE, g_events[1]);
+  TEST_ASSERT_EQUAL_STRING("STATUS", g_line);
+  
+  // The frame arrives exactly as encoded: once, without the delimiters
+  TEST_ASSERT_EQUAL_UINT8(request_length - 2, g_frame_length);
+  TEST_ASSERT_EQUAL_MEMORY(request + 1, g_frame, g_frame_length);
+  
+  // ...and decodes to a request with a good CRC
+  uint8_t decoded[CMD_BUFFER_SIZE];
+  size_t length = cobs_decode(g_frame, g_frame_length, decoded);
+  TEST_ASSERT_EQUAL(sizeof(CmdHeader_t) + sizeof(CmdRecord_t) + sizeof(CmdManual_t) + 2, length);
+  uint16_t crc;
+  memcpy(&crc, decoded + length - 2, sizeof(crc));
+  TEST_ASSERT_EQUAL_HEX16(crc16(decoded, length - 2), crc);
+  TEST_ASSERT_EQUAL_HEX8(CMD_FRAME_TYPE, decoded[0]);
+}
+
+void test_text_line_then_frame(void) {
+  uint8_t request[40];
+  size_t request_length = build_manual_request(request);
+  
+  feed_text("HELP\r\n");
+  feed(request, request_length);
+  
+  TEST_ASSERT_EQUAL_UINT8(2, g_event_count);
+  TEST_ASSERT_EQUAL(RX_LINE, g_events[0]);
+  TEST_ASSERT_EQUAL(RX_FRAME, g_events[1]);
+  TEST_ASSERT_EQUAL_STRING("HELP", g_line);
+}
+
+void test_frame_drops_partial_line(void) {
+  uint8_t request[40];
+  size_t request_length = build_manual_request(request);
+  
+  feed_text("GARB");
+  feed(request, request_length);
+  feed_text("AUTO\n");
+  
+  TEST_ASSERT_EQUAL_UINT8(2, g_event_count);
+  TEST_ASSERT_EQUAL(RX_FRAME, g_events[0]);
+  TEST_ASSERT_EQUAL_STRING("AUTO", g_line);
+}
+
+void test_oversized_frame_is_rejected(void) {
+  uint8_t bytes[CMD_MAX_ENCODED + 3];
+  memset(bytes, 0x55, sizeof(bytes));
+  bytes[0] = CMD_FRAME_DELIMITER;
+  bytes[sizeof(bytes) - 1] = CMD_FRAME_DELIMITER;
+  
+  feed(bytes, sizeof(bytes));
+  feed_text("PING\n");
+  
+  TEST_ASSERT_EQUAL_UINT8(2, g_event_count);
+  TEST_ASSERT_EQUAL(RX_BAD_FRAME, g_events[0]);
+  TEST_ASSERT_EQUAL(RX_LINE, g_events[1]);
+  TEST_ASSERT_EQUAL_STRING("PING", g_line);
+}
+
+void test_stalled_frame_times_out(void) {
+  const uint8_t partial[] = { CMD_FRAME_DELIMITER, 0x03, 'C', 0x01 };
+  feed(partial, sizeof(partial));
+  
+  g_now += CMD_FRAME_TIMEOUT_MS + 1;
+  feed_text("STATUS\n");
+  
+  TEST_ASSERT_EQUAL_UINT8(1, g_event_count);
+  TEST_ASSERT_EQUAL(RX_LINE, g_events[0]);
+  TEST_ASSERT_EQUAL_STRING("STATUS", g_line);
+}
+
+void test_long_line_is_rejected(void) {
+  char line[CMD_BUFFER_SIZE + 1];
+  memset(line, 'A', CMD_BUFFER_SIZE);
+  line[CMD_BUFFER_SIZE] = '\0';
+  
+  feed_text(line);
+  feed_text("\nAUTO\n");
+  
+  TEST_ASSERT_EQUAL(RX_LINE_TOO_LONG, g_events[0]);
+  TEST_ASSERT_EQUAL(RX_LINE, g_events[g_event_count - 1]);
+  TEST_ASSERT_EQUAL_STRING("AUTO", g_line);
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_frame_then_text_line);
+  RUN_TEST(test_text_line_then_frame);
+  RUN_TEST(test_frame_drops_partial_line);
+  RUN_TEST(test_oversized_frame_is_rejected);
+  RUN_TEST(test_stalled_frame_times_out);
+  RUN_TEST(test_long_line_is_rejected);
+  return UNITY_END();
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+/**
+ * @file test_main.cpp
+ * @brief Host tests for the sorting and median networks
+ *
+ * A comparator network sorts (or selects) every input iff it does so for
+ * every 0/1 input (Knuth's 0-1 principle), so each size is checked
+ * exhaustively over 2^N binary vectors, then against random data.
+ */
+
+#include <unity.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils/sample_filter.h"
+
+static uint32_t g_seed;
+
+static uint16_t random_sample() {
+  g_seed = g_seed * 1664525UL + 1013904223UL;
+  return (uint16_t)((g_seed >> 16) & 0x3FF);
+}
+
+static int compare_u16(const void* a, const void* b) {
+  return (int)*(const uint16_t*)a - (int)*(const uint16_t*)b;
+}
+
+template<uint8_t N>
+static void check_sort_zero_one() {
+  for (uint32_t bits = 0; bits < (1UL << N); bits++) {
+    uint16_t v[N];
+    uint8_t ones = 0;
+    for (uint8_t i = 0; i < N; i++) {
+      v[i] = (bits >> i) & 1;
+      ones += v[i];
+    }
+    sort_network<N>(v);
+    for (uint8_t i = 0; i < N; i++) {
+      TEST_ASSERT_EQUAL_UINT16(i >= N - ones ? 1 : 0, v[i]);
+    }
+  }
+}
+
+template<uint8_t N>
+static void check_median_zero_one() {
+  for (uint32_t bits = 0; bits < (1UL << N); bits++) {
+    uint16_t v[N];
+    uint8_t ones = 0;
+    for (uint8_t i = 0; i < N; i++) {
+      v[i] = (bits >> i) & 1;
+      ones += v[i];
+    }
+    // The middle of N sorted bits is 1 iff the ones are the majority
+    TEST_ASSERT_EQUAL_UINT16(ones > N / 2 ? 1 : 0, MedianNetwork<N>::apply(v));
+  }
+}
+
+template<uint8_t N>
+static void check_median_random() {
+  for (int trial = 0; trial < 2000; trial++) {
+    uint16_t v[N];
+    uint16_t ref[N];
+    for (uint8_t i = 0; i < N; i++) {
+      v[i] = ref[i] = random_sample();
+    }
+    qsort(ref, N, sizeof(ref[0]), compare_u16);
+    TEST_ASSERT_EQUAL_UINT16(ref[N / 2], filter_median<N>(v));
+  }
+}
+
+void setUp(void) {
+  g_seed = 1;
+}
+
+void tearDown(void) {}
+
+void test_sort_network_sorts_all_binary_inputs(void) {
+  check_sort_zero_one<1>();
+  check_sort_zero_one<2>();
+  check_sort_zero_one<3>();
+  check_sort_zero_one<4>();
+  check_sort_zero_one<5>();
+  check_sort_zero_one<6>();
+  check_sort_zero_one<7>();
+  check_sort_zero_one<8>();
+  check_sort_zero_one<9>();
+  check_sort_zero_one<10>();
+  check_sort_zero_one<16>();
+}
+
+void test_median_networks_select_on_all_binary_inputs(void) {
+  check_median_zero_one<3>();
+  check_median_zero_one<5>();
+  check_median_zero_one<7>();
+  check_median_zero_one<9>();
+  // Generic fallback
+  check_median_zero_one<11>();
+}
+
+void test_median_matches_sorted_reference(void) {
+  check_median_random<3>();
+  check_median_random<5>();
+  check_median_random<7>();
+  check_median_random<9>();
+  check_median_random<11>();
+}
+
+void test_even_median_averages_middle_pair(void) {
+  uint16_t v[4] = { 40, 10, 31, 20 };
+  TEST_ASSERT_EQUAL_UINT16(26, filter_median<4>(v));
+}
+
+void test_median_rejects_single_spike(void) {
+  uint16_t v[5] = { 500, 502, 1023, 499, 501 };
+  TEST_ASSERT_EQUAL_UINT16(501, filter_median<5>(v));
+}
+
+void test_trimmed_mean_drops_extremes(void) {
+  uint16_t v[5] = { 0, 100, 1023, 102, 104 };
+  TEST_ASSERT_EQUAL_UINT16(102, (filter_trimmed_mean<5, 1>(v)));
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_sort_network_sorts_all_binary_inputs);
+  RUN_TEST(test_median_networks_select_on_all_binary_inputs);
+  RUN_TEST(test_median_matches_sorted_reference);
+  RUN_TEST(test_even_median_averages_middle_pair);
+  RUN_TEST(test_median_rejects_single_spike);
+  RUN_TEST(test_trimmed_mean_drops_extremes);
+  return UNITY_END();
+}
\ No newline at end of file
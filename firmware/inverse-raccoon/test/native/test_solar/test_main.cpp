@@ -0,0 +1,251 @@
+/**
+ * @file test_main.cpp
+ * @brief Host tests for the fixed-point trig tables and solar position
+ *        against a double-precision evaluation of the same NOAA equations
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include "utils/trig.h"
+#include "utils/solar.h"
+
+#define UNIX_2024_01_01   1704067200UL
+#define DEG               (M_PI / 180.0)
+
+typedef struct {
+  const char* name;
+  int16_t latitude_cdeg;
+  int16_t longitude_cdeg;
+} Site_t;
+
+static const Site_t k_sites[] = {
+  { "Quito",    -18, -7847 },
+  { "London",  5151,   -13 },
+  { "Phoenix", 3345, -11207 },
+  { "Sydney", -3387, 15121 },
+  { "Tromso",  6965,  1896 }
+};
+
+#define SITE_COUNT (sizeof(k_sites) / sizeof(k_sites[0]))
+
+static double angle_deg(Angle_t a) {
+  return a.raw() / (double)Angle_t::ONE;
+}
+
+static double bam_to_rad(BinaryAngle_t bam) {
+  return bam * (2.0 * M_PI / BAM_PER_TURN);
+}
+
+/**
+ * @brief Wrap a difference into (-180, 180]
+ */
+static double wrap_deg(double d) {
+  while (d > 180.0) d -= 360.0;
+  while (d <= -180.0) d += 360.0;
+  return d;
+}
+
+/**
+ * @brief NOAA general solar position in double precision
+ */
+static void reference_position(uint32_t unix_seconds, double latitude_deg, double longitude_deg,
+                               double* azimuth_deg, double* elevation_deg) {
+  // Every test time falls in 2024 (leap year)
+  double day = (unix_seconds - UNIX_2024_01_01) / 86400.0;
+  double doy = floor(day);
+  double hour = (day - doy) * 24.0;
+  double g = 2.0 * M_PI / 366.0 * (doy + (hour - 12.0) / 24.0);
+  
+  double eqtime = 229.18 * (0.000075 + 0.001868 * cos(g) - 0.032077 * sin(g) -
+                            0.014615 * cos(2 * g) - 0.040849 * sin(2 * g));
+  double dec = 0.006918 - 0.399912 * cos(g) + 0.070257 * sin(g) - 0.006758 * cos(2 * g) +
+               0.000907 * sin(2 * g) - 0.002697 * cos(3 * g) + 0.00148 * sin(3 * g);
+  double solar_minutes = hour * 60.0 + eqtime + 4.0 * longitude_deg;
+  double ha = (solar_minutes / 4.0 - 180.0) * DEG;
+  double lat = latitude_deg * DEG;
+  
+  double east = -cos(dec) * sin(ha);
+  double north = sin(dec) * cos(lat) - cos(dec) * cos(ha) * sin(lat);
+  double up = sin(dec) * sin(lat) + cos(dec) * cos(ha) * cos(lat);
+  *azimuth_deg = atan2(east, north) / DEG;
+  if (*azimuth_deg < 0) *azimuth_deg += 360.0;
+  *elevation_deg = atan2(up, sqrt(east * east + north * north)) / DEG;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_sin_cos_match_libm(void) {
+  int32_t worst = 0;
+  for (uint32_t a = 0; a < BAM_PER_TURN; a += 7) {
+    int32_t s = lround(sin(bam_to_rad(a)) * 32767);
+    int32_t c = lround(cos(bam_to_rad(a)) * 32767);
+    int32_t ds = abs(trig_sin((BinaryAngle_t)a) - s);
+    int32_t dc = abs(trig_cos((BinaryAngle_t)a) - c);
+    if (ds > worst) worst = ds;
+    if (dc > worst) worst = dc;
+  }
+  printf("  sin/cos worst error %d / 32767\n", (int)worst);
+  TEST_ASSERT_LESS_THAN(8, worst);
+}
+
+void test_sin_cos_exact_at_quadrants(void) {
+  TEST_ASSERT_EQUAL_INT16(0, trig_sin(0));
+  TEST_ASSERT_EQUAL_INT16(32767, trig_sin(BAM_QUARTER_TURN));
+  TEST_ASSERT_EQUAL_INT16(0, trig_sin(2 * BAM_QUARTER_TURN));
+  TEST_ASSERT_EQUAL_INT16(-32767, trig_sin(3 * BAM_QUARTER_TURN));
+  TEST_ASSERT_EQUAL_INT16(32767, trig_cos(0));
+  TEST_ASSERT_EQUAL_INT16(-32767, trig_cos(2 * BAM_QUARTER_TURN));
+}
+
+void test_atan2_matches_libm(void) {
+  double worst = 0.0;
+  for (int i = 0; i < 3600; i++) {
+    double t = i * (2.0 * M_PI / 3600) + 0.0001;
+    double r = (i % 3 == 0) ? 100.0 : ((i % 3 == 1) ? 3000.0 : 30000.0);
+    int32_t y = lround(r * sin(t));
+    int32_t x = lround(r * cos(t));
+    double expected = atan2((double)y, (double)x);
+    double got = bam_to_rad(trig_atan2(y, x));
+    double err = fabs(wrap_deg((got - expected) / DEG));
+    if (err > worst) worst = err;
+  }
+  printf("  atan2 worst error %.4f deg\n", worst);
+  TEST_ASSERT_LESS_THAN(0.02, worst);
+  TEST_ASSERT_EQUAL_UINT16(0, trig_atan2(0, 0));
+  TEST_ASSERT_EQUAL_UINT16(BAM_QUARTER_TURN, trig_atan2(5, 0));
+  TEST_ASSERT_EQUAL_UINT16(2 * BAM_QUARTER_TURN, trig_atan2(0, -5));
+}
+
+void test_isqrt_is_floor(void) {
+  static const uint32_t values[] = { 0, 1, 2, 3, 4, 15, 16, 17, 65535, 65536,
+                                     1073676289UL, 1073741823UL, 4294967295UL };
+  for (unsigned i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    uint32_t r = trig_isqrt(values[i]);
+    TEST_ASSERT_TRUE((uint64_t)r * r <= values[i]);
+    TEST_ASSERT_TRUE((uint64_t)(r + 1) * (r + 1) > values[i]);
+  }
+}
+
+void test_day_of_year_over_whole_unix_range(void) {
+  // Walk the calendar one day at a time from 1970 to the end of uint32_t
+  // time, crossing the non-leap century year 2100
+  uint16_t year = 1970;
+  uint16_t expected_day = 0;
+  for (uint32_t day = 0; day <= 0xFFFFFFFFUL / 86400; day++) {
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    uint16_t expected_length = leap ? 366 : 365;
+    uint16_t length;
+    uint16_t got = solar_day_of_year(day, &length);
+    if (got != expected_day || length != expected_length) {
+      printf("  day %lu (%u): got %u/%u\n", (unsigned long)day, year, got, length);
+    }
+    TEST_ASSERT_EQUAL_UINT16(expected_day, got);
+    TEST_ASSERT_EQUAL_UINT16(expected_length, length);
+    if (++expected_day == expected_length) {
+      expected_day = 0;
+      year++;
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT16(2106, year);
+}
+
+/**
+ * @brief Best-of-5 host time per solar_position() call near a given time
+ */
+static double seconds_per_call(uint32_t unix_seconds) {
+  const int calls = 20000;
+  double best = 1e9;
+  SolarPosition_t got;
+  for (int run = 0; run < 5; run++) {
+    clock_t start = clock();
+    for (int i = 0; i < calls; i++) {
+      solar_position(unix_seconds + i * 60UL, 5151, -13, &got);
+    }
+    double t = (double)(clock() - start) / CLOCKS_PER_SEC / calls;
+    if (t < best) best = t;
+  }
+  return best;
+}
+
+void test_cost_does_not_grow_with_date(void) {
+  // The date split is loop-free; walking years from 1970 made a 2105
+  // evaluation ~3.5x dearer than a 1970 one on the host
+  double early = seconds_per_call(86400UL);
+  double late = seconds_per_call(4291747200UL);
+  printf("  per call: 1970 %.0f ns, 2105 %.0f ns\n", early * 1e9, late * 1e9);
+  TEST_ASSERT_LESS_THAN(early * 1.5, late);
+}
+
+void test_matches_reference_over_a_year(void) {
+  // Every 73 hours through 2024, so each site is seen at all times of day
+  double worst_elevation = 0.0;
+  double worst_azimuth = 0.0;
+  int samples = 0;
+  
+  for (unsigned s = 0; s < SITE_COUNT; s++) {
+    const Site_t* site = &k_sites[s];
+    double site_elevation = 0.0;
+    double site_azimuth = 0.0;
+    for (uint32_t t = UNIX_2024_01_01; t < UNIX_2024_01_01 + 366UL * 86400; t += 73UL * 3600 + 600) {
+      SolarPosition_t got;
+      double azimuth, elevation;
+      solar_position(t, site->latitude_cdeg, site->longitude_cdeg, &got);
+      reference_position(t, site->latitude_cdeg / 100.0, site->longitude_cdeg / 100.0,
+                         &azimuth, &elevation);
+      
+      double de = fabs(angle_deg(got.elevation) - elevation);
+      if (de > site_elevation) site_elevation = de;
+      // Azimuth is ill-conditioned near zenith and meaningless below the horizon
+      if (elevation > 5.0) {
+        double da = fabs(wrap_deg(angle_deg(got.azimuth) - azimuth));
+        if (da > site_azimuth) site_azimuth = da;
+      }
+      samples++;
+    }
+    printf("  %-8s worst elevation %.3f  azimuth %.3f deg\n", site->name, site_elevation, site_azimuth);
+    if (site_elevation > worst_elevation) worst_elevation = site_elevation;
+    if (site_azimuth > worst_azimuth) worst_azimuth = site_azimuth;
+  }
+  
+  TEST_ASSERT_GREATER_THAN(500, samples);
+  TEST_ASSERT_LESS_THAN(0.04, worst_elevation);
+  TEST_ASSERT_LESS_THAN(0.05, worst_azimuth);
+}
+
+void test_equinox_noon_at_equator(void) {
+  // 2024-03-20 12:00 UTC on the Greenwich meridian: sun nearly overhead,
+  // ~1.9 deg east of it (equation of time about -7.5 min)
+  SolarPosition_t got;
+  solar_position(1710936000UL, 0, 0, &got);
+  TEST_ASSERT_DOUBLE_WITHIN(0.2, 88.0, angle_deg(got.elevation));
+  TEST_ASSERT_DOUBLE_WITHIN(5.0, 90.0, angle_deg(got.azimuth));
+}
+
+void test_night_is_below_horizon(void) {
+  // London, 2024-06-21 00:00 UTC
+  SolarPosition_t got;
+  solar_position(1718928000UL, 5151, -13, &got);
+  TEST_ASSERT_LESS_THAN(0.0, angle_deg(got.elevation));
+  // Sun due north (below the pole) at local midnight
+  TEST_ASSERT_LESS_THAN(5.0, fabs(wrap_deg(angle_deg(got.azimuth))));
+}
+
+int main(int argc, char** argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_sin_cos_match_libm);
+  RUN_TEST(test_sin_cos_exact_at_quadrants);
+  RUN_TEST(test_atan2_matches_libm);
+  RUN_TEST(test_isqrt_is_floor);
+  RUN_TEST(test_day_of_year_over_whole_unix_range);
+  RUN_TEST(test_cost_does_not_grow_with_date);
+  RUN_TEST(test_matches_reference_over_a_year);
+  RUN_TEST(test_equinox_noon_at_equator);
+  RUN_TEST(test_night_is_below_horizon);
+  return UNITY_END();
+}
\ No newline at end of file
@@ -0,0 +1,331 @@
+/**
+ * @file telemetry_decode.cpp
+ * @brief Host-side decoder for binary telemetry frames (protocol.h)
+ *
+ * Reads a raw serial stream, extracts COBS frames, checks the CRC and
+ * prints one JSON object or CSV row per frame. Text between frames (boot
+ * banner, command replies) is passed through to stderr.
+ *
+ * Build (from firmware/inverse-raccoon):
+ *   g++ -std=c++11 -O2 -Iinclude tools/telemetry_decode/telemetry_decode.cpp \
+ *       src/utils/cobs.cpp src/utils/crc.cpp -o telemetry_decode
+ *
+ * Use:
+ *   stty -F /dev/ttyACM0 115200 raw
+ *   ./telemetry_decode --csv < /dev/ttyACM0 > run.csv
+ *   ./telemetry_decode --json capture.bin
+ */
+
+#include "protocol.h"
+#include "utils/cobs.h"
+#include "utils/crc.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+enum OutputFormat {
+  OUTPUT_JSON,
+  OUTPUT_CSV
+};
+
+struct Frame {
+  TelemHeader_t header;
+  TelemSensors_t sensors;
+  TelemSun_t sun;
+  TelemServos_t servos;
+  TelemPower_t power;
+  TelemTiming_t timing;
+  TelemErrors_t errors;
+  TelemHealth_t health;
+};
+
+struct DecodeStats {
+  unsigned long frames;
+  unsigned long crc_errors;
+  unsigned long malformed;
+  unsigned long seq_gaps;
+};
+
+static const char* const k_mode_names[] = {
+  "NORMAL", "DEGRADED_1", "DEGRADED_2", "SAFE", "EMERGENCY"
+};
+
+/**
+ * @brief Copy the next section out of the payload if its group is present
+ */
+static bool take_section(const uint8_t* payload, size_t length, size_t* offset,
+                         uint8_t groups, uint8_t group, void* section, size_t size) {
+  if (!(groups & group)) {
+    return true;
+  }
+  if (*offset + size > length) {
+    return false;
+  }
+  memcpy(section, payload + *offset, size);
+  *offset += size;
+  return true;
+}
+
+/**
+ * @brief Validate and unpack one decoded payload
+ */
+static bool parse_frame(const uint8_t* payload, size_t length, Frame* frame, DecodeStats* stats) {
+  // Replies to binary commands share the port but are not telemetry
+  if (length > 0 && payload[0] == CMD_ACK_TYPE) {
+    return false;
+  }
+  if (length < sizeof(TelemHeader_t) + sizeof(uint16_t)) {
+    stats->malformed++;
+    return false;
+  }
+  
+  uint16_t crc;
+  memcpy(&crc, payload + length - sizeof(crc), sizeof(crc));
+  length -= sizeof(crc);
+  if (crc16(payload, length) != crc) {
+    stats->crc_errors++;
+    return false;
+  }
+  
+  memset(frame, 0, sizeof(*frame));
+  memcpy(&frame->header, payload, sizeof(frame->header));
+  if (frame->header.type != TELEM_FRAME_TYPE || frame->header.version != TELEM_PROTOCOL_VERSION) {
+    stats->malformed++;
+    return false;
+  }
+  
+  uint8_t groups = frame->header.groups;
+  size_t offset = sizeof(frame->header);
+  bool ok =
+    take_section(payload, length, &offset, groups, TELEM_GROUP_SENSORS, &frame->sensors, sizeof(frame->sensors)) &&
+    take_section(payload, length, &offset, groups, TELEM_GROUP_SUN, &frame->sun, sizeof(frame->sun)) &&
+    take_section(payload, length, &offset, groups, TELEM_GROUP_SERVOS, &frame->servos, sizeof(frame->servos)) &&
+    take_section(payload, length, &offset, groups, TELEM_GROUP_POWER, &frame->power, sizeof(frame->power)) &&
+    take_section(payload, length, &offset, groups, TELEM_GROUP_TIMING, &frame->timing, sizeof(frame->timing)) &&
+    take_section(payload, length, &offset, groups, TELEM_GROUP_ERRORS, &frame->errors, sizeof(frame->errors)) &&
+    take_section(payload, length, &offset, groups, TELEM_GROUP_HEALTH, &frame->health, sizeof(frame->health));
+  if (!ok || offset != length) {
+    stats->malformed++;
+    return false;
+  }
+  
+  stats->frames++;
+  return true;
+}
+
+static const char* mode_name(uint8_t mode) {
+  return (mode < sizeof(k_mode_names) / sizeof(k_mode_names[0])) ? k_mode_names[mode] : "UNKNOWN";
+}
+
+static double angle(int16_t q) {
+  return (double)q / (1 << TELEM_ANGLE_FRAC);
+}
+
+static void print_json(const Frame* f) {
+  uint8_t g = f->header.groups;
+  printf("{\"seq\":%u,\"uptime_ms\":%lu,\"mode\":\"%s\"",
+         f->header.seq, (unsigned long)f->header.uptime_ms, mode_name(f->header.mode));
+  if (g & TELEM_GROUP_SENSORS) {
+    printf(",\"sensors\":{\"tl\":%u,\"tr\":%u,\"bl\":%u,\"br\":%u,\"valid\":%s,\"bits\":%u,\"gen\":%lu}",
+           f->sensors.ldr[0], f->sensors.ldr[1], f->sensors.ldr[2], f->sensors.ldr[3],
+           f->sensors.valid ? "true" : "false", f->sensors.resolution_bits,
+           (unsigned long)f->sensors.generation);
+  }
+  if (g & TELEM_GROUP_SUN) {
+    printf(",\"sun\":{\"detected\":%s,\"az_error\":%.3f,\"el_error\":%.3f}",
+           f->sun.detected ? "true" : "false", angle(f->sun.azimuth_error), angle(f->sun.elevation_error));
+  }
+  if (g & TELEM_GROUP_SERVOS) {
+    printf(",\"servos\":{\"az\":%.2f,\"el\":%.2f,\"moving\":%s}",
+           f->servos.azimuth_cdeg / 100.0, f->servos.elevation_cdeg / 100.0,
+           f->servos.moving ? "true" : "false");
+  }
+  if (g & TELEM_GROUP_POWER) {
+    printf(",\"power\":{\"attached\":%u,\"duty\":[%.2f,%.2f],\"mah\":%.2f}",
+           f->power.attached_mask, f->power.duty_hundredths[0] / 100.0,
+           f->power.duty_hundredths[1] / 100.0, f->power.charge_mas / 3600.0);
+  }
+  if (g & TELEM_GROUP_TIMING) {
+    printf(",\"timing\":{\"hz\":%u,\"cycles\":%lu,\"lat\":[%u,%u,%u],\"exec\":[%u,%u,%u],\"hist\":[",
+           f->timing.rate_hz, (unsigned long)f->timing.cycles,
+           f->timing.latency_us[0], f->timing.latency_us[1], f->timing.latency_us[2],
+           f->timing.exec_us[0], f->timing.exec_us[1], f->timing.exec_us[2]);
+    for (int i = 0; i < TELEM_JITTER_BUCKETS; i++) {
+      printf(i ? ",%u" : "%u", f->timing.histogram[i]);
+    }
+    printf("],\"sleep\":%.2f}", f->timing.sleep_hundredths / 100.0);
+  }
+  if (g & TELEM_GROUP_ERRORS) {
+    printf(",\"errors\":{\"total\":%lu,\"sensor\":%u,\"servo\":%u,\"tx_skip\":%u}",
+           (unsigned long)f->errors.total, f->errors.sensor, f->errors.servo,
+           f->errors.telemetry_skipped);
+  }
+  if (g & TELEM_GROUP_HEALTH) {
+    printf(",\"health\":{\"channels\":[%u,%u,%u,%u],\"healthy_mask\":%u}",
+           f->health.channel_health[0], f->health.channel_health[1],
+           f->health.channel_health[2], f->health.channel_health[3], f->health.healthy_mask);
+  }
+  printf("}\n");
+}
+
+static void print_csv_header() {
+  printf("seq,uptime_ms,mode,groups,"
+         "ldr_tl,ldr_tr,ldr_bl,ldr_br,sensors_valid,sensor_bits,sensor_gen,"
+         "sun_detected,az_error_deg,el_error_deg,"
+         "servo_az_deg,servo_el_deg,servo_moving,"
+         "attached_mask,duty_az_pct,duty_el_pct,charge_mah,"
+         "rate_hz,cycles,lat_min_us,lat_max_us,lat_mean_us,exec_min_us,exec_max_us,exec_mean_us,");
+  for (int i = 0; i < TELEM_JITTER_BUCKETS; i++) {
+    printf("hist%d,", i);
+  }
+  printf("sleep_pct,errors_total,errors_sensor,errors_servo,tx_skip,"
+         "health_tl,health_tr,health_bl,health_br,healthy_mask\n");
+}
+
+/**
+ * @brief One CSV row; groups absent from the frame leave their columns empty
+ */
+static void print_csv(const Frame* f) {
+  uint8_t g = f->header.groups;
+  printf("%u,%lu,%s,%u,", f->header.seq, (unsigned long)f->header.uptime_ms,
+         mode_name(f->header.mode), g);
+  if (g & TELEM_GROUP_SENSORS) {
+    printf("%u,%u,%u,%u,%u,%u,%lu,", f->sensors.ldr[0], f->sensors.ldr[1], f->sensors.ldr[2],
+           f->sensors.ldr[3], f->sensors.valid, f->sensors.resolution_bits,
+           (unsigned long)f->sensors.generation);
+  } else {
+    printf(",,,,,,,");
+  }
+  if (g & TELEM_GROUP_SUN) {
+    printf("%u,%.3f,%.3f,", f->sun.detected, angle(f->sun.azimuth_error), angle(f->sun.elevation_error));
+  } else {
+    printf(",,,");
+  }
+  if (g & TELEM_GROUP_SERVOS) {
+    printf("%.2f,%.2f,%u,", f->servos.azimuth_cdeg / 100.0, f->servos.elevation_cdeg / 100.0,
+           f->servos.moving);
+  } else {
+    printf(",,,");
+  }
+  if (g & TELEM_GROUP_POWER) {
+    printf("%u,%.2f,%.2f,%.2f,", f->power.attached_mask, f->power.duty_hundredths[0] / 100.0,
+           f->power.duty_hundredths[1] / 100.0, f->power.charge_mas / 3600.0);
+  } else {
+    printf(",,,,");
+  }
+  if (g & TELEM_GROUP_TIMING) {
+    printf("%u,%lu,%u,%u,%u,%u,%u,%u,", f->timing.rate_hz, (unsigned long)f->timing.cycles,
+           f->timing.latency_us[0], f->timing.latency_us[1], f->timing.latency_us[2],
+           f->timing.exec_us[0], f->timing.exec_us[1], f->timing.exec_us[2]);
+    for (int i = 0; i < TELEM_JITTER_BUCKETS; i++) {
+      printf("%u,", f->timing.histogram[i]);
+    }
+    printf("%.2f,", f->timing.sleep_hundredths / 100.0);
+  } else {
+    printf(",,,,,,,,");
+    for (int i = 0; i < TELEM_JITTER_BUCKETS; i++) {
+      printf(",");
+    }
+    printf(",");
+  }
+  if (g & TELEM_GROUP_ERRORS) {
+    printf("%lu,%u,%u,%u,", (unsigned long)f->errors.total, f->errors.sensor, f->errors.servo,
+           f->errors.telemetry_skipped);
+  } else {
+    printf(",,,,");
+  }
+  if (g & TELEM_GROUP_HEALTH) {
+    printf("%u,%u,%u,%u,%u\n", f->health.channel_health[0], f->health.channel_health[1],
+           f->health.channel_health[2], f->health.channel_health[3], f->health.healthy_mask);
+  } else {
+    printf(",,,,\n");
+  }
+}
+
+/**
+ * @brief Handle the bytes between two delimiters
+ */
+static void handle_block(const std::vector<uint8_t>& block, OutputFormat format,
+                         DecodeStats* stats, bool* have_seq, uint16_t* last_seq) {
+  if (block.empty()) {
+    return;
+  }
+  
+  std::vector<uint8_t> payload(block.size());
+  size_t length = cobs_decode(block.data(), block.size(), payload.data());
+  Frame frame;
+  if (length > 0 && parse_frame(payload.data(), length, &frame, stats)) {
+    if (*have_seq && (uint16_t)(*last_seq + 1) != frame.header.seq) {
+      stats->seq_gaps++;
+    }
+    *have_seq = true;
+    *last_seq = frame.header.seq;
+    
+    if (format == OUTPUT_CSV) {
+      print_csv(&frame);
+    } else {
+      print_json(&frame);
+    }
+    fflush(stdout);
+    return;
+  }
+  
+  // Not a frame: most likely log text sent while binary telemetry was on
+  fwrite(block.data(), 1, block.size(), stderr);
+}
+
+int main(int argc, char** argv) {
+  OutputFormat format = OUTPUT_JSON;
+  FILE* input = stdin;
+  
+  const uint16_t probe = 1;
+  if (*(const uint8_t*)&probe != 1) {
+    fprintf(stderr, "telemetry_decode: little-endian host required\n");
+    return 1;
+  }
+  
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--csv") == 0) {
+      format = OUTPUT_CSV;
+    } else if (strcmp(argv[i], "--json") == 0) {
+      format = OUTPUT_JSON;
+    } else if (argv[i][0] == '-') {
+      fprintf(stderr, "usage: %s [--csv|--json] [capture.bin]\n", argv[0]);
+      return 1;
+    } else {
+      input = fopen(argv[i], "rb");
+      if (input == nullptr) {
+        perror(argv[i]);
+        return 1;
+      }
+    }
+  }
+  
+  if (format == OUTPUT_CSV) {
+    print_csv_header();
+  }
+  
+  DecodeStats stats = {};
+  bool have_seq = false;
+  uint16_t last_seq = 0;
+  std::vector<uint8_t> block;
+  int c;
+  while ((c = fgetc(input)) != EOF) {
+    if (c == TELEM_FRAME_DELIMITER) {
+      handle_block(block, format, &stats, &have_seq, &last_seq);
+      block.clear();
+    } else if (block.size() < 4096) {
+      block.push_back((uint8_t)c);
+    }
+  }
+  handle_block(block, format, &stats, &have_seq, &last_seq);
+  
+  fprintf(stderr, "\ntelemetry_decode: %lu frames, %lu CRC errors, %lu malformed, %lu sequence gaps\n",
+          stats.frames, stats.crc_errors, stats.malformed, stats.seq_gaps);
+  
+  if (input != stdin) {
+    fclose(input);
+  }
+  return 0;
+}
\ No newline at end of file